@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "AppSettings.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+    constexpr const char *s_usage =
+        "[--settings FILE] [--host-api NAME] [--device NAME|INDEX] [--frames N] [--latency MS]\n"
+        "       [--realtime] [--rt-priority N] [--lock-memory] [--audio-core N]\n"
+        "       [--max-fps N] [--idle-fps N] [--list-devices]";
+
+    template <typename T>
+    bool ParseNumber(std::string_view text, T& value) {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    // A device can be given by name or by index
+    std::string GetDevice(const json& audio, const std::string& current) {
+        auto it = audio.find("device");
+        if (it == audio.end()) {
+            return current;
+        }
+        return it->is_number_integer() ? std::to_string(it->get<int>()) : it->get<std::string>();
+    }
+
+    bool LoadFromFile(const fs::path& path, AppSettings& settings) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Couldn't open the settings file " << path << std::endl;
+            return false;
+        }
+
+        // Read into a copy, so that a broken file changes nothing
+        AppSettings loaded = settings;
+        try {
+            json j;
+            file >> j;
+
+            const json audio = j.value("audio", json::object());
+            loaded.audio.hostApi = audio.value("hostApi", loaded.audio.hostApi);
+            loaded.audio.device = GetDevice(audio, loaded.audio.device);
+            loaded.audio.framesPerBuffer = audio.value("framesPerBuffer", loaded.audio.framesPerBuffer);
+            loaded.audio.latencyMs = audio.value("latencyMs", loaded.audio.latencyMs);
+
+            const json system = j.value("system", json::object());
+            loaded.realtime.realtimePriority = system.value("realtime", loaded.realtime.realtimePriority);
+            loaded.realtime.priority = system.value("priority", loaded.realtime.priority);
+            loaded.realtime.lockMemory = system.value("lockMemory", loaded.realtime.lockMemory);
+            loaded.realtime.audioCore = system.value("audioCore", loaded.realtime.audioCore);
+
+            const json gui = j.value("gui", json::object());
+            loaded.frameRates.maxFPS = gui.value("maxFPS", loaded.frameRates.maxFPS);
+            loaded.frameRates.idleFPS = gui.value("idleFPS", loaded.frameRates.idleFPS);
+        }catch (const std::exception& e) {
+            std::cerr << "Invalid settings file " << path << ": " << e.what() << std::endl;
+            return false;
+        }
+
+        settings = loaded;
+        return true;
+    }
+
+    bool ParseOption(std::string_view arg, std::string_view value, AppSettings& settings) {
+        if (arg == "--host-api") {
+            settings.audio.hostApi = value;
+        }else if (arg == "--device") {
+            settings.audio.device = value;
+        }else if (arg == "--frames") {
+            return ParseNumber(value, settings.audio.framesPerBuffer);
+        }else if (arg == "--latency") {
+            return ParseNumber(value, settings.audio.latencyMs);
+        }else if (arg == "--rt-priority") {
+            return ParseNumber(value, settings.realtime.priority);
+        }else if (arg == "--audio-core") {
+            return ParseNumber(value, settings.realtime.audioCore);
+        }else if (arg == "--max-fps") {
+            return ParseNumber(value, settings.frameRates.maxFPS);
+        }else if (arg == "--idle-fps") {
+            return ParseNumber(value, settings.frameRates.idleFPS);
+        }
+        return true;
+    }
+
+    bool IsValid(const AppSettings& settings) {
+        if (settings.audio.latencyMs < 0.0) {
+            std::cerr << "The latency can't be negative" << std::endl;
+            return false;
+        }
+        if (settings.realtime.priority < 1 || settings.realtime.priority > 99) {
+            std::cerr << "The real-time priority must be in [1, 99]" << std::endl;
+            return false;
+        }
+        if (settings.realtime.audioCore < -1) {
+            std::cerr << "The audio core can't be negative" << std::endl;
+            return false;
+        }
+        if (settings.frameRates.maxFPS < 1 || settings.frameRates.idleFPS < 1) {
+            std::cerr << "The frame rates must be at least 1" << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+bool AppSettingsIO::Load(int argc, char** argv, AppSettings& settings) {
+    // The file first, so that the command line overrides it wherever the options are
+    fs::path settingsPath = AppSettings::DEFAULT_FILE;
+    bool isDefaultPath = true;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string_view(argv[i]) == "--settings") {
+            settingsPath = argv[i + 1];
+            isDefaultPath = false;
+        }
+    }
+
+    std::error_code error;
+    if ((!isDefaultPath || fs::exists(settingsPath, error)) && !LoadFromFile(settingsPath, settings)) {
+        return false;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        // The switches without a value
+        if (arg == "--list-devices") {
+            settings.listDevices = true;
+            continue;
+        }else if (arg == "--realtime") {
+            settings.realtime.realtimePriority = true;
+            continue;
+        }else if (arg == "--lock-memory") {
+            settings.realtime.lockMemory = true;
+            continue;
+        }
+
+        static constexpr std::string_view options[] = {
+            "--settings", "--host-api", "--device", "--frames", "--latency", "--rt-priority", "--audio-core",
+            "--max-fps", "--idle-fps"
+        };
+        if (std::find(std::begin(options), std::end(options), arg) == std::end(options)) {
+            std::cerr << "Unknown option: " << arg << "\nUsage: " << argv[0] << " " << s_usage << std::endl;
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        std::string_view value = argv[++i];
+        if (!ParseOption(arg, value, settings)) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+    }
+
+    return IsValid(settings);
+}
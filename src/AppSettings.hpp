@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <filesystem>
+
+#include "engine/AudioDeviceSettings.hpp"
+#include "gui/FrameRateSettings.hpp"
+#include "system/RealtimeSettings.hpp"
+
+// The settings of the application that aren't part of a preset, tuned per machine: which audio
+// device to play through and with what latency, how to schedule the threads, and how often to
+// redraw. They are read from a JSON file, and each can be overridden from the command line:
+//
+//   chirp [--settings FILE] [--host-api NAME] [--device NAME|INDEX] [--frames N] [--latency MS]
+//         [--realtime] [--rt-priority N] [--lock-memory] [--audio-core N]
+//         [--max-fps N] [--idle-fps N] [--list-devices]
+//
+// The file holds the same settings, all optional:
+//
+//   { "audio": { "hostApi": "ALSA", "device": "USB", "framesPerBuffer": 128, "latencyMs": 5 },
+//     "system": { "realtime": true, "priority": 70, "lockMemory": true, "audioCore": 3 },
+//     "gui": { "maxFPS": 60, "idleFPS": 10 } }
+struct AppSettings {
+    static inline const std::filesystem::path DEFAULT_FILE = "chirp_settings.json";
+
+    AudioDeviceSettings audio;
+    RealtimeSettings realtime;
+    FrameRateSettings frameRates;
+    bool listDevices = false; // Print the output devices and exit, rather than start
+};
+
+namespace AppSettingsIO {
+
+// Reads the settings file (DEFAULT_FILE in the working directory, if it exists, unless --settings
+// names another) and then the command line over it. Returns false after saying what's wrong if
+// either can't be used.
+bool Load(int argc, char** argv, AppSettings& settings);
+
+} // namespace AppSettingsIO
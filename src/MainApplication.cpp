@@ -3,20 +3,53 @@
 
 #include "MainApplication.hpp"
 #include "preset/BuiltInPresetsLoader.hpp"
+#include "system/ThreadTuning.hpp"
 
-MainApplication::MainApplication()
-    : m_preset(std::make_shared<AudioPreset>())
+MainApplication::MainApplication(const AppSettings& settings)
+    : m_deviceSettings(settings.audio)
+    , m_realtime(settings.realtime)
+    , m_partPresets(CreatePartPresets())
+    , m_partRouting(std::make_shared<PartRoutingTable>(s_numParts))
     , m_fftComputer(std::make_shared<FFTComputer>())
-    , m_gui(m_preset, m_fftComputer)
-    , m_audioEngine(m_preset, m_fftComputer)
-{}
+    , m_events(std::make_shared<EngineEventQueue>())
+    , m_gui(m_partPresets, m_partRouting, m_fftComputer, m_events, settings.frameRates)
+    , m_audioEngine(m_partPresets, m_partRouting, m_fftComputer, m_events)
+{
+    m_fftComputer->SetSlowestRequestRate(settings.frameRates.idleFPS);
+}
+
+std::vector<std::shared_ptr<PresetPublisher>> MainApplication::CreatePartPresets() {
+    std::vector<std::shared_ptr<PresetPublisher>> partPresets;
+    for (size_t part = 0; part < s_numParts; part++) {
+        partPresets.push_back(std::make_shared<PresetPublisher>());
+    }
+    return partPresets;
+}
+
+void MainApplication::PinThreads(std::thread& fftThread) {
+    if (m_realtime.audioCore >= 0) {
+        ThreadTuning::Result result = ThreadTuning::PinAwayFromCore(fftThread.native_handle(), m_realtime.audioCore);
+        ThreadTuning::Report("Keeping the analysis thread off the audio core", result);
+
+        // This thread goes on to run the GUI
+        result = ThreadTuning::PinAwayFromCore(ThreadTuning::GetCurrentThread(), m_realtime.audioCore);
+        ThreadTuning::Report("Keeping the GUI thread off the audio core", result);
+    }
+}
 
 void MainApplication::Start() {
-    BuiltInPresetsLoader::GetShared().LoadDefaultPreset(*m_preset);
+    AudioPreset preset;
+    BuiltInPresetsLoader::GetShared().LoadDefaultPreset(preset);
+    m_gui.SetPreset(preset);
+
+    // Before the audio starts, so that everything it touches has been faulted in already
+    if (m_realtime.lockMemory) {
+        ThreadTuning::Report("Locking memory", ThreadTuning::LockMemory());
+    }
 
     // Start the mixer in its own thread
     std::thread audioThread([&]() {
-        m_audioEngine.Start(m_isRunning);
+        m_audioEngine.Start(m_isRunning, m_deviceSettings, m_realtime);
     });
 
     // Start the FFT computer in its own thread
@@ -24,6 +57,8 @@ void MainApplication::Start() {
         m_fftComputer->Start(m_isRunning);
     });
 
+    PinThreads(fftThread);
+
     // Start gui on main thread, blocks until application closes
     m_gui.RunMainLoop();
 
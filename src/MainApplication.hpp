@@ -7,23 +7,40 @@
 // They need to be included first in order not to cause any conflicts with preferred integral types.
 #include "gui/GUIManager.hpp"
 #include "engine/AudioEngine.hpp"
-#include "preset/AudioPreset.hpp"
+#include "preset/PresetPublisher.hpp"
 #include "fft/FFTComputer.hpp"
+#include "engine/EngineEventQueue.hpp"
+#include "engine/PartRouting.hpp"
+#include "AppSettings.hpp"
 
 #include <memory>
 #include <iostream>
 #include <thread>
 #include <atomic>
+#include <vector>
 
 class MainApplication {
 public:
-    MainApplication();
+    explicit MainApplication(const AppSettings& settings = {});
 
     void Start();
 
 private:
-    std::shared_ptr<AudioPreset> m_preset;
+    // Independent instruments, each with its own preset, layered or split across the keyboard
+    static constexpr size_t s_numParts = 4;
+
+    static std::vector<std::shared_ptr<PresetPublisher>> CreatePartPresets();
+
+    // Keeps the analysis and GUI threads off the audio core, if the settings pick one.
+    // The engine tunes its own threads.
+    void PinThreads(std::thread& fftThread);
+
+    AudioDeviceSettings m_deviceSettings;
+    RealtimeSettings m_realtime;
+    std::vector<std::shared_ptr<PresetPublisher>> m_partPresets;
+    std::shared_ptr<PartRoutingTable> m_partRouting;
     std::shared_ptr<FFTComputer> m_fftComputer;
+    std::shared_ptr<EngineEventQueue> m_events;
     GUIManager m_gui;
     AudioEngine m_audioEngine;
 
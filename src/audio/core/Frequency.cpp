@@ -4,7 +4,6 @@
 #include <algorithm>
 
 #include "core/Frequency.hpp"
-#include "engine/AudioEngine.hpp"
 
 Frequency::Frequency(float hertz)
     : m_hertz(hertz)
@@ -35,10 +34,7 @@ void Frequency::AddPitchModulation(float semitones) {
 }
 
 float Frequency::GetAbsolute() const {
-    // The maximum pitch we should support is half the sample rate (Nyquist theorem)
-    // Otherwise we'd get foldback aliasing.
-    float actual = m_hertz * std::pow(2.0, (m_pitchBase + m_pitchModulation) / m_notesPerOctave);
-    return std::min(actual, static_cast<float>(SAMPLE_RATE / 2.0));
+    return m_hertz * std::pow(2.0, (m_pitchBase + m_pitchModulation) / m_notesPerOctave);
 }
 
 float Frequency::ConvertNoteToHz(Note note) {
@@ -40,6 +40,11 @@ struct Note {
     auto operator==(const Note& other) const -> bool {
         return octave == other.octave && key == other.key;
     }
+
+    // Semitones above the A of octave 0, so notes compare and form ranges as plain numbers
+    auto GetIndex() const -> int {
+        return octave * 12 + key;
+    }
 };
 
 class Frequency {
@@ -53,6 +58,8 @@ public:
     void ClearModulations();
     void AddPitchModulation(float semitones);
 
+    // In hertz, including the pitch. Not limited to the Nyquist frequency, which depends on
+    // the sample rate, so the code turning it into samples limits it.
     float GetAbsolute() const;
 
 private:
@@ -26,10 +26,25 @@ std::unique_ptr<Waveform> Waveform::ConstructWaveform(WaveformInfo::Type type) {
     return nullptr;
 }
 
+void Waveform::GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) {
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        samples[lane] = GetSampleAt(offsets[lane]);
+    }
+}
+
 float Saw::GetSampleAt(float currentOffset) {
     return -1.0f + 2.0f * currentOffset;
 }
 
+void Saw::GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) {
+    (void)numLanes; // Sampling every lane costs the same
+    WaveformInfo::Lanes out; // Can't alias the offsets, so the loop vectorizes
+    for (size_t lane = 0; lane < WaveformInfo::LANE_WIDTH; lane++) {
+        out[lane] = -1.0f + 2.0f * offsets[lane];
+    }
+    samples = out;
+}
+
 float Sine::GetSampleAt(float currentOffset) {
     return std::sin(currentOffset * 2.0 * std::numbers::pi);
 }
@@ -38,6 +53,15 @@ float Square::GetSampleAt(float currentOffset) {
     return currentOffset >= 0.5f ? 1.0f : -1.0f;
 }
 
+void Square::GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) {
+    (void)numLanes; // Sampling every lane costs the same
+    WaveformInfo::Lanes out;
+    for (size_t lane = 0; lane < WaveformInfo::LANE_WIDTH; lane++) {
+        out[lane] = offsets[lane] >= 0.5f ? 1.0f : -1.0f;
+    }
+    samples = out;
+}
+
 float WhiteNoise::GetSampleAt(float currentOffset) {
     (void)currentOffset;
     
@@ -50,6 +74,16 @@ float Triangle::GetSampleAt(float currentOffset) {
     return 4.0f * std::fabs(phase - 0.5f) - 1.0f;
 }
 
+void Triangle::GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) {
+    (void)numLanes; // Sampling every lane costs the same
+    // The offsets are always in [0, 1), where the fmod() above changes nothing
+    WaveformInfo::Lanes out;
+    for (size_t lane = 0; lane < WaveformInfo::LANE_WIDTH; lane++) {
+        out[lane] = 4.0f * std::fabs(offsets[lane] - 0.5f) - 1.0f;
+    }
+    samples = out;
+}
+
 float Organ::GetSampleAt(float currentOffset) {
     float fundamental = std::sin(currentOffset * 2.0 * std::numbers::pi);
     float third = 0.4f * std::sin(currentOffset * 2.0 * std::numbers::pi * 3.0f);
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "core/Frequency.hpp"
+#include <array>
+#include <cstddef>
 #include <random>
 #include <memory>
 
@@ -18,6 +20,11 @@ namespace WaveformInfo {
     };
 
     inline constexpr const char* Names[] = { "Saw", "Sine", "Square", "White noise", "Triangle", "Organ" };
+
+    // Waveforms can be sampled at several offsets at once, a block of lanes that the
+    // compiler turns into SIMD instructions (two SSE or one AVX register of floats)
+    constexpr size_t LANE_WIDTH = 8;
+    using Lanes = std::array<float, LANE_WIDTH>;
 }
 
 // Base class for representing waveforms, such as sine waves or more complex waves  
@@ -25,12 +32,18 @@ class Waveform {
 public:
     // Returns the sample value at a specific offset in the waveform in the range [0, 1]
     virtual float GetSampleAt(float offset) = 0;
+
+    // Samples each lane at its own offset. Only the first numLanes are needed: waveforms without a
+    // vectorized version sample just those, lane by lane, and leave the rest as they are.
+    virtual void GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes);
+
     static std::unique_ptr<Waveform> ConstructWaveform(WaveformInfo::Type type);
 };
 
 class Saw final : public Waveform {
 public:
     float GetSampleAt(float offset) override;
+    void GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) override;
 };
 
 class Sine final : public Waveform {
@@ -41,6 +54,7 @@ public:
 class Square final : public Waveform {
 public:
     float GetSampleAt(float offset) override;
+    void GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) override;
 };
 
 class WhiteNoise final : public Waveform {
@@ -55,6 +69,7 @@ private:
 class Triangle final : public Waveform {
 public:
     float GetSampleAt(float offset) override;
+    void GetSamplesAt(const WaveformInfo::Lanes& offsets, WaveformInfo::Lanes& samples, size_t numLanes) override;
 };
 
 class Organ final : public Waveform {
@@ -2,7 +2,6 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "effects/BaseFilter.hpp"
-#include "engine/AudioEngine.hpp"
 #include "effects/LowPassFilter.hpp"
 #include "effects/HighPassFilter.hpp"
 
@@ -31,6 +30,15 @@ void BaseFilter::SetCutoffAndPeaking(Frequency cutoff, float Q) {
     ComputeAndApplyCoefficients();
 }
 
+void BaseFilter::PrepareImpl() {
+    ComputeAndApplyCoefficients();
+}
+
+float BaseFilter::GetCutoffHz() const {
+    float maxCutoff = std::min(s_maxCutoff, s_maxCutoffToSampleRate * GetSampleRate());
+    return std::clamp(m_cutoff.GetAbsolute(), s_minCutoff, maxCutoff);
+}
+
 void BaseFilter::ClearModulationsImpl() {
     m_cutoff.ClearModulations();
     m_modulationQ = 0.0f;
@@ -27,10 +27,15 @@ public:
     void ClearModulationsImpl() override;
     void ApplyModulation(float amount, ModulationType modType) override;
 
+    void PrepareImpl() override;
+
 protected:
     // Is called every time cutoff or Q is modified, otherwise the changes won't take effect.
     virtual void ComputeAndApplyCoefficients() = 0;
 
+    // The modulated cutoff, kept in the range the filter is stable for at the current sample rate
+    float GetCutoffHz() const;
+
     // Cutoff frequency
     Frequency m_cutoff;
     float m_Q;
@@ -43,4 +48,5 @@ protected:
     static inline const float s_maxCutoff = 20000.0f;
     static inline const float MIN_Q = 0.1f; // To avoid division-by-zero
     static inline const float MAX_Q = 5.0f;
+    static inline const float s_maxCutoffToSampleRate = 0.49f; // Just below Nyquist
 };
\ No newline at end of file
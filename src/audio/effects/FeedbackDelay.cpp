@@ -3,10 +3,31 @@
 
 #include "effects/FeedbackDelay.hpp"
 
+#include <algorithm>
+
+namespace {
+    // The low bits of a layout that hold the number of lines. Line capacities are powers of two
+    // of at least 4, so they never reach into them.
+    constexpr size_t s_numLinesMask = 3;
+}
+
+FeedbackDelay::DelayMemory::DelayMemory(size_t layout)
+    : lineCapacity(layout & ~s_numLinesMask)
+    , numLines(layout & s_numLinesMask)
+    , samples(lineCapacity * numLines, 0.0f)
+{}
+
+size_t FeedbackDelay::DelayMemory::GetSize() const {
+    return GetLayout(numLines, lineCapacity);
+}
+
+size_t FeedbackDelay::DelayMemory::GetSizeInBytes() const {
+    return samples.size() * sizeof(float);
+}
+
 FeedbackDelay::FeedbackDelay() 
     : m_leftLine(m_delayTime, m_feedback)
     , m_rightLine(m_delayTime, m_feedback)
-    , m_monoLine(m_delayTime, m_feedback)
 {
     UpdateDelayLines();
 }
@@ -14,7 +35,6 @@ FeedbackDelay::FeedbackDelay()
 FeedbackDelay::FeedbackDelay(FeedbackDelayInfo::Type delayType, float delayTime, float feedback)
     : m_leftLine(delayTime, feedback)
     , m_rightLine(delayTime, feedback)
-    , m_monoLine(delayTime, feedback)
 {
     SetDelayType(delayType);
     SetDelayTime(delayTime);
@@ -44,7 +64,6 @@ void FeedbackDelay::SetFeedback(float feedback) noexcept {
     m_feedback = feedback;
     m_leftLine.SetFeedback(feedback);
     m_rightLine.SetFeedback(feedback);
-    m_monoLine.SetFeedback(feedback);
 }
 
 void FeedbackDelay::ProcessFrame(AudioFrame& output) {
@@ -55,7 +74,7 @@ void FeedbackDelay::ProcessFrame(AudioFrame& output) {
     switch (m_delayType) {
         case FeedbackDelayInfo::Type::Mono: {
             // Feed average of input into mono delay line
-            float out = m_monoLine.Process(avg);
+            float out = m_leftLine.Process(avg);
             output += AudioFrame{ out, out };
             break;
         }
@@ -75,6 +94,39 @@ void FeedbackDelay::ProcessFrame(AudioFrame& output) {
     }
 }
 
+void FeedbackDelay::SyncResourcesImpl() {
+    size_t requiredLines = isOn ? GetNumLinesUsedBy(m_delayType) : 0;
+    DelayMemory *memory = m_memory.Sync(GetLayout(requiredLines, GetLineCapacity()));
+    if (memory && memory->lineCapacity != GetLineCapacity()) {
+        memory = nullptr; // Laid out for another sample rate, wait for the replacement
+    }
+    if (memory != m_attachedMemory) {
+        AttachMemory(memory);
+    }
+}
+
+void FeedbackDelay::ManageResourcesImpl() {
+    m_memory.Manage();
+}
+
+void FeedbackDelay::PrepareImpl() {
+    // The lines must let go of their memory before their capacity changes. Memory that still fits
+    // the new capacity is attached again by the next SyncResources(), so clear the history of the
+    // old rate out of it. Any other stays unused, and the delay silent, until ManageResources()
+    // has replaced it.
+    if (m_attachedMemory) {
+        std::fill(m_attachedMemory->samples.begin(), m_attachedMemory->samples.end(), 0.0f);
+    }
+    AttachMemory(nullptr);
+    m_leftLine.SetSampleRate(GetSampleRate());
+    m_rightLine.SetSampleRate(GetSampleRate());
+    m_preDelay.SetSampleRate(GetSampleRate());
+}
+
+size_t FeedbackDelay::GetMemoryUsage() const {
+    return m_memory.GetAllocatedBytes();
+}
+
 void FeedbackDelay::UpdateDelayLines() noexcept {
     if (m_delayType == FeedbackDelayInfo::Type::PingPong) {
         // Since we want to offset one channel by half the delay time,
@@ -86,6 +138,44 @@ void FeedbackDelay::UpdateDelayLines() noexcept {
     }else {
         m_leftLine.SetDelayTime(m_delayTime);
         m_rightLine.SetDelayTime(m_delayTime);
-        m_monoLine.SetDelayTime(m_delayTime);
     }
-}
\ No newline at end of file
+}
+
+size_t FeedbackDelay::GetNumLinesUsedBy(FeedbackDelayInfo::Type delayType) noexcept {
+    switch (delayType) {
+        case FeedbackDelayInfo::Type::Mono:
+            return 1;
+        case FeedbackDelayInfo::Type::Stereo:
+            return 2;
+        case FeedbackDelayInfo::Type::PingPong:
+            return 3;
+    }
+    return 3;
+}
+
+size_t FeedbackDelay::GetLineCapacity() const {
+    return std::max(FeedbackDelayLine::GetRequiredCapacity(GetSampleRate()), Delay::GetRequiredCapacity(GetSampleRate()));
+}
+
+size_t FeedbackDelay::GetLayout(size_t numLines, size_t lineCapacity) noexcept {
+    // No lines means no memory at all, whatever their capacity
+    return numLines > 0 ? lineCapacity | numLines : 0;
+}
+
+void FeedbackDelay::AttachMemory(DelayMemory *memory) noexcept {
+    m_attachedMemory = memory;
+    m_leftLine.Detach();
+    m_rightLine.Detach();
+    m_preDelay.Detach();
+    if (!memory) {
+        return;
+    }
+
+    // Lines without memory output silence, which only happens briefly while switching delay type
+    const size_t capacity = memory->lineCapacity;
+    const size_t numLines = memory->numLines;
+    float *samples = memory->samples.data();
+    if (numLines > 0) m_leftLine.Attach(samples);
+    if (numLines > 1) m_rightLine.Attach(samples + capacity);
+    if (numLines > 2) m_preDelay.Attach(samples + 2 * capacity);
+}
@@ -7,10 +7,14 @@
 #include "effects/util/FeedbackDelayLine.hpp"
 #include "engine/AudioProcessor.hpp"
 #include "effects/util/Delay.hpp"
+#include "synchronization/LazyResource.hpp"
+
+#include <vector>
 
 // Adds a looping delay effect that repeats audio but with less volume (depending on feedback)
 // The processed audio contains both dry input signal and wet delay tail
-class FeedbackDelay : public AudioProcessor {
+// Delay memory is only allocated while the effect is on, and only for the lines the delay type uses.
+class FeedbackDelay final : public AudioProcessor {
 public:
     FeedbackDelay();
     FeedbackDelay(FeedbackDelayInfo::Type delayType, float delayTime, float feedback);
@@ -21,18 +25,46 @@ public:
 
     void ProcessFrame(AudioFrame& output) override;
 
+    void SyncResourcesImpl() override;
+    void ManageResourcesImpl() override;
+    void PrepareImpl() override;
+    size_t GetMemoryUsage() const override;
+
 private:
+    // One contiguous block of sample memory, split between the lines in use. Requested by layout
+    // rather than by size: the line capacity, a power of two, with the number of lines in its low
+    // bits. Memory laid out for another sample rate then never passes for the current one, even
+    // where both need as many samples.
+    struct DelayMemory {
+        explicit DelayMemory(size_t layout);
+        size_t GetSize() const; // The layout
+        size_t GetSizeInBytes() const;
+
+        size_t lineCapacity;
+        size_t numLines;
+        std::vector<float> samples;
+    };
+
     void UpdateDelayLines() noexcept;
 
+    // Number of lines (left, right, pre-delay, in that order) a delay type reads from
+    static size_t GetNumLinesUsedBy(FeedbackDelayInfo::Type delayType) noexcept;
+    size_t GetLineCapacity() const;
+    static size_t GetLayout(size_t numLines, size_t lineCapacity) noexcept;
+    void AttachMemory(DelayMemory *memory) noexcept;
+
     FeedbackDelayInfo::Type m_delayType = FeedbackDelayInfo::Type::Mono;
     float m_delayTime = 0.2f;
     float m_feedback = 0.5;
 
+    // The left line doubles as the mono line, since mono mode never uses both
     FeedbackDelayLine m_leftLine;
     FeedbackDelayLine m_rightLine;
-    FeedbackDelayLine m_monoLine;
 
     // Will be utilized for ping-pong effect, where one channel gets offset in time
     // to alternate between left/right delays.
     Delay m_preDelay;
-};
\ No newline at end of file
+
+    LazyResource<DelayMemory> m_memory;
+    DelayMemory *m_attachedMemory = nullptr;
+};
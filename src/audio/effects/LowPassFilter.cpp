@@ -2,7 +2,6 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "effects/LowPassFilter.hpp"
-#include "engine/AudioEngine.hpp"
 #include <numbers>
 
 LowPassFilter::LowPassFilter(Frequency cutoff, float Q) : BaseFilter(cutoff, Q) {
@@ -10,8 +9,8 @@ LowPassFilter::LowPassFilter(Frequency cutoff, float Q) : BaseFilter(cutoff, Q)
 }
 
 void LowPassFilter::ComputeAndApplyCoefficients() {
-    float cutoffHz = std::clamp(m_cutoff.GetAbsolute(), s_minCutoff, s_maxCutoff);
-    float omega0 = 2.0f * std::numbers::pi * cutoffHz / SAMPLE_RATE;
+    float cutoffHz = GetCutoffHz();
+    float omega0 = 2.0f * std::numbers::pi * cutoffHz / GetSampleRate();
     float Q = std::clamp(m_Q + m_modulationQ, MIN_Q, MAX_Q);
     float alpha = std::sin(omega0) / (2.0f * Q);
     float cosOmega0 = std::cos(omega0);
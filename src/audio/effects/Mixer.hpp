@@ -7,7 +7,7 @@
 
 // The Mixer class doesn't provide any extra functionality, but is a great semantically to use
 // if the only thing you need is to group together outputs.
-class Mixer : public AudioProcessor {
+class Mixer final : public AudioProcessor {
 public:
     // Empty implementation means audio passes through.
     void ProcessFrame(AudioFrame&) override {}
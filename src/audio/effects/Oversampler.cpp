@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "effects/Oversampler.hpp"
+
+#include <cmath>
+
+Oversampler::Oversampler(OversamplingInfo::Factor factor)
+    : m_filters{ HalfBandFilter(16), HalfBandFilter(8), HalfBandFilter(4) }
+    , m_numStages(static_cast<size_t>(factor))
+{}
+
+void Oversampler::AddStage(std::shared_ptr<AudioProcessor> stage) {
+    m_stages.push_back(stage);
+    PrepareStages();
+}
+
+void Oversampler::SetFactor(OversamplingInfo::Factor factor) {
+    size_t numStages = static_cast<size_t>(factor);
+    if (numStages == m_numStages) {
+        return;
+    }
+
+    // The filter states belong to the old rates, start over from silence
+    m_numStages = numStages;
+    for (HalfBandFilter& filter : m_filters) {
+        filter.Reset();
+    }
+    PrepareStages();
+}
+
+void Oversampler::ProcessFrame(AudioFrame& output) {
+    // Upsample one 2x stage at a time
+    m_frames[0] = output;
+    size_t numFrames = 1;
+    for (size_t s = 0; s < m_numStages; s++) {
+        for (size_t i = 0; i < numFrames; i++) {
+            m_filters[s].Upsample(m_frames[i], &m_scratch[2 * i]);
+        }
+        numFrames *= 2;
+        std::copy(m_scratch.begin(), m_scratch.begin() + numFrames, m_frames.begin());
+    }
+
+    for (size_t i = 0; i < numFrames; i++) {
+        for (const std::shared_ptr<AudioProcessor>& stage : m_stages) {
+            stage->ProcessFrame(m_frames[i]);
+        }
+    }
+
+    // Back down, undoing the stages in reverse order
+    for (size_t s = m_numStages; s-- > 0;) {
+        numFrames /= 2;
+        for (size_t i = 0; i < numFrames; i++) {
+            m_frames[i] = m_filters[s].Downsample(&m_frames[2 * i]);
+        }
+    }
+
+    output = m_frames[0];
+}
+
+void Oversampler::SyncResourcesImpl() {
+    for (const std::shared_ptr<AudioProcessor>& stage : m_stages) {
+        stage->SyncResources();
+    }
+}
+
+void Oversampler::ManageResourcesImpl() {
+    for (const std::shared_ptr<AudioProcessor>& stage : m_stages) {
+        stage->ManageResources();
+    }
+}
+
+void Oversampler::PrepareImpl() {
+    PrepareStages();
+}
+
+void Oversampler::PrepareStages() {
+    // Every oversampled frame is one frame of each stage, so their blocks grow by the factor too
+    ProcessSpec spec = GetProcessSpec();
+    size_t factor = size_t(1) << m_numStages;
+    spec.sampleRate *= static_cast<float>(factor);
+    spec.maxBlockSize *= factor;
+    for (const std::shared_ptr<AudioProcessor>& stage : m_stages) {
+        stage->Prepare(spec);
+    }
+}
+
+float Oversampler::GetLatencySamples() const {
+    // Each stage's latency is counted at its own rate, convert them all to the base rate
+    float latency = 0.0f;
+    float rate = 1.0f;
+    for (size_t s = 0; s < m_numStages; s++) {
+        rate *= 2.0f;
+        latency += m_filters[s].GetLatency() * 2.0f / rate;
+    }
+
+    for (const std::shared_ptr<AudioProcessor>& stage : m_stages) {
+        latency += stage->GetLatencySamples() / rate;
+    }
+    return latency;
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "effects/util/HalfBandFilter.hpp"
+#include "effects/util/OversamplingInfo.hpp"
+#include "engine/AudioProcessor.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+// Runs a chain of processing stages at 2x, 4x or 8x the sample rate, so nonlinear stages
+// (saturation, clipping, ...) don't fold their harmonics back into the audible range.
+// The input (the sum of the children) is upsampled by cascaded half-band filters, every stage
+// processes each of the oversampled frames in series, and the result is filtered and decimated
+// back down. Only the ProcessFrame() of the stages is used: their own children, gain, pan
+// and mix are ignored, those belong on the oversampler itself.
+// The stages are prepared for the raised sample rate.
+class Oversampler final : public AudioProcessor {
+public:
+    Oversampler(OversamplingInfo::Factor factor = OversamplingInfo::Factor::x2);
+
+    // Appends a stage to the oversampled chain. Not meant to be called while audio is running.
+    void AddStage(std::shared_ptr<AudioProcessor> stage);
+
+    // Prepares the stages for the new rate, so like Prepare() not while audio is running
+    void SetFactor(OversamplingInfo::Factor factor);
+
+    void ProcessFrame(AudioFrame& output) override;
+
+    void SyncResourcesImpl() override;
+    void ManageResourcesImpl() override;
+    void PrepareImpl() override;
+
+    float GetLatencySamples() const override;
+
+private:
+    void PrepareStages();
+
+    static constexpr size_t MAX_STAGES = 3;
+    static constexpr size_t MAX_FACTOR = 1 << MAX_STAGES;
+
+    // The first stage handles the band closest to the audible range and needs the steepest filter,
+    // later stages run at higher rates where the wide transition band doesn't matter
+    std::array<HalfBandFilter, MAX_STAGES> m_filters;
+    size_t m_numStages;
+
+    std::vector<std::shared_ptr<AudioProcessor>> m_stages;
+
+    // Ping-pong buffers for the oversampled frames, so processing never allocates
+    std::array<AudioFrame, MAX_FACTOR> m_frames;
+    std::array<AudioFrame, MAX_FACTOR> m_scratch;
+};
@@ -3,16 +3,56 @@
 
 #include "effects/Reverb.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <numbers>
 
+Reverb::ReverbMemory::ReverbMemory(size_t numFrames)
+    : frames(numFrames, AudioFrame())
+{}
+
+size_t Reverb::ReverbMemory::GetSize() const {
+    return frames.size();
+}
+
+size_t Reverb::ReverbMemory::GetSizeInBytes() const {
+    return frames.size() * sizeof(AudioFrame);
+}
+
+namespace {
+    // Reasonable delay lengths at 44.1 kHz (prime numbers help)
+    constexpr int s_combDelays[] = {1116, 1188, 1277, 1356};
+    constexpr int s_allpassDelays[] = {225, 556};
+}
+
 Reverb::Reverb()
-    : combDelays{1116, 1188, 1277, 1356} // Choose reasonable delay lengths (prime numbers help)
-    , allpassDelays{225, 556}
+    : combDelays(std::size(s_combDelays))
+    , allpassDelays(std::size(s_allpassDelays))
+    , combOffsets(std::size(s_combDelays))
+    , allpassOffsets(std::size(s_allpassDelays))
     , combFilterState(4) {
+    LayOutBuffers();
+}
 
-    // Initialize buffers
-    for (auto d : combDelays) combBuffers.emplace_back(d, AudioFrame());
-    for (auto d : allpassDelays) allpassBuffers.emplace_back(d, AudioFrame());
+void Reverb::LayOutBuffers() {
+    float scale = GetSampleRate() / s_tuningSampleRate;
+    auto scaleDelay = [scale](int delay) {
+        return std::max(1, static_cast<int>(std::lround(delay * scale)));
+    };
+
+    // Lay out the buffers back to back, the memory itself is allocated once the reverb is turned on
+    totalBufferFrames = 0;
+    for (size_t i = 0; i < combDelays.size(); i++) {
+        combDelays[i] = scaleDelay(s_combDelays[i]);
+        combOffsets[i] = totalBufferFrames;
+        totalBufferFrames += combDelays[i];
+    }
+    for (size_t i = 0; i < allpassDelays.size(); i++) {
+        allpassDelays[i] = scaleDelay(s_allpassDelays[i]);
+        allpassOffsets[i] = totalBufferFrames;
+        totalBufferFrames += allpassDelays[i];
+    }
 }
 
 void Reverb::SetParams(float feedback, float damping, float wet) {
@@ -22,13 +62,17 @@ void Reverb::SetParams(float feedback, float damping, float wet) {
 }
 
 void Reverb::ProcessFrame(AudioFrame& output) {
+    if (!m_attachedMemory) {
+        return; // Buffers not allocated yet, let the dry signal through
+    }
+
     AudioFrame in = output;
 
     // --- Parallel comb filters ---
     AudioFrame combOut;
-    for (size_t i = 0; i < combBuffers.size(); ++i)
+    for (size_t i = 0; i < combDelays.size(); ++i)
     {
-        std::vector<AudioFrame>& buf = combBuffers[i];
+        AudioFrame *buf = m_attachedMemory->frames.data() + combOffsets[i];
         int delay = combDelays[i];
         AudioFrame& filterState = combFilterState[i];
 
@@ -41,14 +85,14 @@ void Reverb::ProcessFrame(AudioFrame& output) {
     }
 
     // --- Normalize wet level ---
-    combOut /= static_cast<float>(combBuffers.size());
+    combOut /= static_cast<float>(combDelays.size());
     combOut *= 1.5f;  // restore energy after averaging
 
     // --- Series allpass filters for diffusion ---
     AudioFrame apOut = combOut;
-    for (size_t i = 0; i < allpassBuffers.size(); ++i)
+    for (size_t i = 0; i < allpassDelays.size(); ++i)
     {
-        std::vector<AudioFrame>& buf = allpassBuffers[i];
+        AudioFrame *buf = m_attachedMemory->frames.data() + allpassOffsets[i];
         int delay = allpassDelays[i];
         AudioFrame bufOut = buf[posAllpass[i]];
 
@@ -64,11 +108,37 @@ void Reverb::ProcessFrame(AudioFrame& output) {
     wetMix = std::clamp(wetMix, 0.0f, 1.0f);
     float dryGain = std::cos(wetMix * static_cast<float>(std::numbers::pi / 2.0));
     float wetGain = std::sin(wetMix * static_cast<float>(std::numbers::pi / 2.0));
-    AudioFrame out = in * dryGain + apOut * wetGain;
+    output = in * dryGain + apOut * wetGain;
+
+    // The output is soft clipped by an oversampled Saturator following the reverb in the layout
+}
 
-    // --- Soft clip for safety (prevents runaway feedback) ---
-    out.left = std::tanh(out.left); // keeps output in [-1, 1] smoothly
-    out.right = std::tanh(out.right);
+void Reverb::SyncResourcesImpl() {
+    ReverbMemory *memory = m_memory.Sync(isOn ? totalBufferFrames : 0);
+    if (memory && memory->GetSize() != totalBufferFrames) {
+        memory = nullptr; // Laid out for another sample rate, wait for the replacement
+    }
+    if (memory != m_attachedMemory) {
+        // Fresh buffers are silent, so restart the filters from silence too
+        m_attachedMemory = memory;
+        std::fill(combFilterState.begin(), combFilterState.end(), AudioFrame());
+        std::fill(posComb.begin(), posComb.end(), 0);
+        std::fill(posAllpass.begin(), posAllpass.end(), 0);
+    }
+}
 
-    output = out;
-}
\ No newline at end of file
+void Reverb::ManageResourcesImpl() {
+    m_memory.Manage();
+}
+
+void Reverb::PrepareImpl() {
+    m_attachedMemory = nullptr;
+    LayOutBuffers();
+    std::fill(combFilterState.begin(), combFilterState.end(), AudioFrame());
+    std::fill(posComb.begin(), posComb.end(), 0);
+    std::fill(posAllpass.begin(), posAllpass.end(), 0);
+}
+
+size_t Reverb::GetMemoryUsage() const {
+    return m_memory.GetAllocatedBytes();
+}
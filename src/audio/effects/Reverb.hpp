@@ -6,8 +6,10 @@
 #include <vector>
 #include "engine/AudioProcessor.hpp"
 #include "engine/AudioFrame.hpp"
+#include "synchronization/LazyResource.hpp"
 
-class Reverb : public AudioProcessor {
+// The comb and allpass buffers are only allocated while the reverb is on.
+class Reverb final : public AudioProcessor {
 public:
     Reverb();
 
@@ -15,12 +17,35 @@ public:
 
     void ProcessFrame(AudioFrame& output) override;
 
+    void SyncResourcesImpl() override;
+    void ManageResourcesImpl() override;
+    void PrepareImpl() override;
+    size_t GetMemoryUsage() const override;
+
 private:
+    // The delay lengths are tuned for this rate and scaled to the actual one, so the reverb sounds the same at any rate
+    static constexpr float s_tuningSampleRate = 44100.0f;
+
+    // Scales the delays to the sample rate and lays out their buffers
+    void LayOutBuffers();
+
+    // All comb and allpass buffers, stored back to back in one allocation
+    struct ReverbMemory {
+        explicit ReverbMemory(size_t numFrames);
+        size_t GetSize() const;
+        size_t GetSizeInBytes() const;
+
+        std::vector<AudioFrame> frames;
+    };
+
     std::vector<int> combDelays;
     std::vector<int> allpassDelays;
 
-    std::vector<std::vector<AudioFrame>> combBuffers;
-    std::vector<std::vector<AudioFrame>> allpassBuffers;
+    // Where each buffer starts within ReverbMemory::frames
+    std::vector<size_t> combOffsets;
+    std::vector<size_t> allpassOffsets;
+    size_t totalBufferFrames = 0;
+
     std::vector<AudioFrame> combFilterState;
     std::vector<int> posComb = {0,0,0,0};
     std::vector<int> posAllpass = {0,0};
@@ -28,4 +53,7 @@ private:
     float feedback = 0.8f;
     float damp = 0.2f;
     float wetMix = 0.3f;
-};
\ No newline at end of file
+
+    LazyResource<ReverbMemory> m_memory;
+    ReverbMemory *m_attachedMemory = nullptr;
+};
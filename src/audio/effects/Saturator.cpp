@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "effects/Saturator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+Saturator::Saturator(float drive)
+    : m_drive(drive)
+{}
+
+void Saturator::SetDrive(float drive) noexcept {
+    m_drive = std::max(drive, 0.0f);
+}
+
+void Saturator::ProcessFrame(AudioFrame& output) {
+    output.left = std::tanh(output.left * m_drive);
+    output.right = std::tanh(output.right * m_drive);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "engine/AudioProcessor.hpp"
+
+// Smooth tanh saturation. Drive boosts the signal before the curve, so higher values
+// distort more while the output still stays within [-1, 1].
+// Generates harmonics above the input bandwidth, so run it inside an Oversampler.
+class Saturator final : public AudioProcessor {
+public:
+    Saturator(float drive = 1.0f);
+
+    void SetDrive(float drive) noexcept;
+
+    void ProcessFrame(AudioFrame& output) override;
+
+private:
+    float m_drive;
+};
@@ -2,39 +2,61 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "effects/util/Delay.hpp"
-#include "engine/AudioEngine.hpp"
+
+#include <algorithm>
 
 Delay::Delay(float delaySeconds)
 {
     SetDelay(delaySeconds);
+    m_currentDelaySamples = m_targetDelaySamples; // Don't glide from zero on construction
+}
+
+size_t Delay::GetRequiredCapacity(float sampleRate) {
+    return DelayBuffer::GetCapacityFor(static_cast<size_t>(std::ceil(MAX_DELAY_SEC * sampleRate)));
+}
+
+void Delay::SetSampleRate(float sampleRate) noexcept {
+    m_sampleRate = sampleRate;
+    SetDelay(m_delaySeconds);
+    m_currentDelaySamples = m_targetDelaySamples;
+}
+
+void Delay::Attach(float *memory) noexcept {
+    m_buffer.Attach(memory, GetRequiredCapacity(m_sampleRate));
+    m_currentDelaySamples = m_targetDelaySamples; // Fresh memory, nothing to glide from
+}
+
+void Delay::Detach() noexcept {
+    m_buffer.Detach();
 }
 
 // Set delay in seconds
-void Delay::SetDelay(float delaySeconds) {
-    m_delayInSeconds = delaySeconds;
-    size_t newDelaySamples = static_cast<size_t>(std::round(m_delayInSeconds * SAMPLE_RATE)) + 1; // +1 for safety margin
-    if (m_buffer.size() != newDelaySamples) {
-        m_buffer.resize(newDelaySamples, 0.0f);
-        m_writeIndex = 0;
-    }
+void Delay::SetDelay(float delaySeconds) noexcept {
+    m_delaySeconds = std::clamp(delaySeconds, 0.0f, MAX_DELAY_SEC);
+    m_targetDelaySamples = m_delaySeconds * m_sampleRate;
+}
+
+void Delay::SetInterpolation(DelayInterpolation::Type interpolation) noexcept {
+    m_interpolation = interpolation;
 }
 
 // Process one sample at a time
-float Delay::Process(float input) {
-    if (m_buffer.empty()) {
-        return input;
+float Delay::Process(float input) noexcept {
+    if (m_buffer.IsEmpty()) {
+        return 0.0f; // No memory attached yet
     }
 
-    int delaySamples = static_cast<int>(std::round(m_delayInSeconds * SAMPLE_RATE));
-    int readIndex = m_writeIndex - delaySamples;
-    if (readIndex < 0) {
-        readIndex += static_cast<int>(m_buffer.size());
+    if (m_currentDelaySamples != m_targetDelaySamples) {
+        m_currentDelaySamples += (m_targetDelaySamples - m_currentDelaySamples) * s_smoothingAlpha;
+        if (std::abs(m_targetDelaySamples - m_currentDelaySamples) < s_snapThreshold) {
+            m_currentDelaySamples = m_targetDelaySamples;
+        }
     }
 
-    float delayedSample = m_buffer[readIndex];
-
-    m_buffer[m_writeIndex] = input;  // store current input in delay buffer
-    m_writeIndex = (m_writeIndex + 1) % m_buffer.size();  // wrap around
+    m_buffer.Write(input);
+    return m_buffer.Read(m_currentDelaySamples, m_interpolation);
+}
 
-    return delayedSample;
+void Delay::Clear() noexcept {
+    m_buffer.Clear();
 }
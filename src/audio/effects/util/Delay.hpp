@@ -3,24 +3,56 @@
 
 #pragma once
 
+#include "effects/util/DelayBuffer.hpp"
+#include "engine/ProcessSpec.hpp"
+
 #include <vector>
 #include <cmath>
 
 // A DSP block that implements a delay (not to confuse with feedback delay).
 // It simply shifts the signal in time (no feeding back to itself).
 // Used for example to shift one channel in the ping-pong feedback delay effect.
+// The sample memory is owned by the effect using the delay and attached with Attach().
+// Without memory attached, the delay outputs silence.
 class Delay {
 public:
+    static constexpr float MAX_DELAY_SEC = 10.0f;
+
     Delay(float delaySeconds = 0.0f);
 
-    // Set delay in seconds
-    void SetDelay(float delaySeconds);
+    // Number of samples of memory that must be attached to serve delays up to MAX_DELAY_SEC
+    static size_t GetRequiredCapacity(float sampleRate);
+
+    // Not while memory is attached, since the required capacity changes with it
+    void SetSampleRate(float sampleRate) noexcept;
+
+    // Starts using the given memory (of GetRequiredCapacity() samples at the current rate, cleared) as sample history
+    void Attach(float *memory) noexcept;
+
+    // Stops using the attached memory
+    void Detach() noexcept;
+
+    // Set delay in seconds. The actual delay glides towards the new value to avoid clicks.
+    void SetDelay(float delaySeconds) noexcept;
+
+    void SetInterpolation(DelayInterpolation::Type interpolation) noexcept;
 
     // Process one sample at a time
-    float Process(float input);
+    float Process(float input) noexcept;
+
+    // Reset the delay buffer to silence
+    void Clear() noexcept;
 
 private:
-    float m_delayInSeconds;
-    std::vector<float> m_buffer;
-    int m_writeIndex = 0;
+    DelayBuffer m_buffer;
+    DelayInterpolation::Type m_interpolation = DelayInterpolation::Type::Lagrange;
+    float m_sampleRate = ProcessSpec::DEFAULT_SAMPLE_RATE;
+    float m_delaySeconds = 0.0f;
+    float m_targetDelaySamples = 0.0f;
+    float m_currentDelaySamples = 0.0f;
+
+    // The rate at which the current delay approaches the target delay per sample
+    static inline const float s_smoothingAlpha = 0.0005f;
+    // Below this distance (in samples) the glide snaps to the target and stops
+    static inline const float s_snapThreshold = 0.001f;
 };
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace DelayInterpolation {
+    enum class Type {
+        Linear,
+        Lagrange // 3rd order, flatter response than linear at the cost of two extra taps
+    };
+}
+
+// Single-channel circular sample history used by the delay building blocks.
+// The capacity is a power of two so wrapping is a bitwise AND rather than a modulo.
+// The buffer doesn't own its memory: the owning effect allocates it off the audio thread and
+// attaches it here, so neither changing the delay time nor enabling the effect allocates.
+// Reads are fractional, which lets the delay time glide smoothly instead of jumping between samples.
+class DelayBuffer {
+public:
+    // Returns the power-of-two capacity needed to serve delays up to maxDelaySamples
+    static size_t GetCapacityFor(size_t maxDelaySamples) {
+        // A few extra samples of headroom for the interpolation taps
+        return std::bit_ceil(maxDelaySamples + 4);
+    }
+
+    // Uses the given memory as sample history. The capacity must be a power of two,
+    // and the memory is expected to be cleared already.
+    void Attach(float *data, size_t capacity) noexcept {
+        m_data = data;
+        m_mask = capacity - 1;
+        m_writeIndex = 0;
+    }
+
+    // Stops referring to the attached memory, so that its owner can release it
+    void Detach() noexcept {
+        m_data = nullptr;
+        m_mask = 0;
+        m_writeIndex = 0;
+    }
+
+    void Clear() noexcept {
+        if (m_data) {
+            std::fill(m_data, m_data + GetCapacity(), 0.0f);
+        }
+        m_writeIndex = 0;
+    }
+
+    bool IsEmpty() const noexcept {
+        return m_data == nullptr;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return m_data ? m_mask + 1 : 0;
+    }
+
+    // The largest delay (in samples) that Read() can serve, keeping room for the interpolation taps
+    float GetMaxDelay() const noexcept {
+        return m_data ? static_cast<float>(m_mask + 1 - 3) : 0.0f;
+    }
+
+    void Write(float sample) noexcept {
+        m_data[m_writeIndex] = sample;
+        m_writeIndex = (m_writeIndex + 1) & m_mask;
+    }
+
+    // Returns the sample written `delay` samples before the most recent one (0 = most recent).
+    // The delay must be in the range [0, GetMaxDelay()].
+    float Read(float delay, DelayInterpolation::Type interpolation) const noexcept {
+        size_t whole = static_cast<size_t>(delay);
+        float frac = delay - static_cast<float>(whole);
+        size_t index = (m_writeIndex - 1 - whole) & m_mask;
+
+        float y0 = m_data[index];
+        float y1 = m_data[(index - 1) & m_mask];
+
+        if (interpolation == DelayInterpolation::Type::Linear || whole == 0) {
+            // The Lagrange kernel needs one sample newer than y0, which doesn't exist for whole == 0
+            return y0 + frac * (y1 - y0);
+        }
+
+        float yNewer = m_data[(index + 1) & m_mask];
+        float y2 = m_data[(index - 2) & m_mask];
+
+        // 4-point Lagrange interpolation at position frac between y0 and y1
+        float fp1 = frac + 1.0f;
+        float fm1 = frac - 1.0f;
+        float fm2 = frac - 2.0f;
+        float cNewer = -frac * fm1 * fm2 * (1.0f / 6.0f);
+        float c0 = fp1 * fm1 * fm2 * 0.5f;
+        float c1 = -fp1 * frac * fm2 * 0.5f;
+        float c2 = fp1 * frac * fm1 * (1.0f / 6.0f);
+        return cNewer * yNewer + c0 * y0 + c1 * y1 + c2 * y2;
+    }
+
+private:
+    float *m_data = nullptr;
+    size_t m_mask = 0;
+    size_t m_writeIndex = 0;
+};
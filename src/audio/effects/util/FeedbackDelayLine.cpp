@@ -2,57 +2,74 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "effects/util/FeedbackDelayLine.hpp"
-#include "engine/AudioEngine.hpp"
 #include <cmath>
 
 FeedbackDelayLine::FeedbackDelayLine(float delayTime, float feedback) {
-    Init();
     SetDelayTime(delayTime);
     SetFeedback(feedback);
+    m_currentDelaySamples = m_targetDelaySamples; // Don't glide from zero on construction
 }
 
-void FeedbackDelayLine::Init() {
+size_t FeedbackDelayLine::GetRequiredCapacity(float sampleRate) {
     // Safety clamp
     const float safeMaxDelay = std::max(MAX_DELAY_SEC, MIN_DELAY_SEC);
+    return DelayBuffer::GetCapacityFor(static_cast<size_t>(std::ceil(safeMaxDelay * sampleRate)));
+}
+
+void FeedbackDelayLine::SetSampleRate(float sampleRate) noexcept {
+    m_sampleRate = sampleRate;
+    SetDelayTime(m_delaySeconds);
+    m_currentDelaySamples = m_targetDelaySamples;
+}
 
-    m_bufferSize = static_cast<size_t>(std::ceil(safeMaxDelay * SAMPLE_RATE)) + 1;
+void FeedbackDelayLine::Attach(float *memory) noexcept {
+    m_buffer.Attach(memory, GetRequiredCapacity(m_sampleRate));
+    m_currentDelaySamples = m_targetDelaySamples; // Fresh memory, nothing to glide from
+}
 
-    m_buffer.assign(m_bufferSize, 0.0f);
-    m_writeIndex = 0;
-    m_delaySamples = 0;
-    m_feedback = 0.5f;
+void FeedbackDelayLine::Detach() noexcept {
+    m_buffer.Detach();
 }
 
 void FeedbackDelayLine::SetDelayTime(float seconds) noexcept{
-    // Clamp to available buffer size
-    float clamped = std::clamp(seconds, MIN_DELAY_SEC, static_cast<float>(m_bufferSize - 1) / SAMPLE_RATE);
-    m_delaySamples = static_cast<size_t>(clamped * SAMPLE_RATE);
+    // Clamp to the range the memory is sized for. The read happens before the current input is written,
+    // so a delay of N samples means reading N - 1 samples behind the most recent write.
+    m_delaySeconds = std::clamp(seconds, MIN_DELAY_SEC, MAX_DELAY_SEC);
+    m_targetDelaySamples = m_delaySeconds * m_sampleRate - 1.0f;
 }
 
 void FeedbackDelayLine::SetFeedback(float fb) noexcept {
     m_feedback = std::clamp(fb, 0.0f, MAX_FEEDBACK);
 }
 
-float FeedbackDelayLine::Process(float input) noexcept {
-    if (m_bufferSize == 0) {
-        return input; // not initialized yet, pass-through
+void FeedbackDelayLine::SetInterpolation(DelayInterpolation::Type interpolation) noexcept {
+    m_interpolation = interpolation;
+}
+
+void FeedbackDelayLine::StepDelaySmoothing() noexcept {
+    if (m_currentDelaySamples == m_targetDelaySamples) {
+        return;
+    }
+    m_currentDelaySamples += (m_targetDelaySamples - m_currentDelaySamples) * s_smoothingAlpha;
+    if (std::abs(m_targetDelaySamples - m_currentDelaySamples) < s_snapThreshold) {
+        m_currentDelaySamples = m_targetDelaySamples;
     }
+}
 
-    const size_t readIndex =
-        (m_writeIndex + m_bufferSize - m_delaySamples) % m_bufferSize;
+float FeedbackDelayLine::Process(float input) noexcept {
+    if (m_buffer.IsEmpty()) {
+        return 0.0f; // No memory attached, so there is nothing to repeat
+    }
 
-    const float delayed = m_buffer[readIndex];
+    StepDelaySmoothing();
+    const float delayed = m_buffer.Read(m_currentDelaySamples, m_interpolation);
 
     // Write new sample (input + delayed * feedback)
-    m_buffer[m_writeIndex] = input + delayed * m_feedback;
-
-    // Advance write index (circular buffer)
-    m_writeIndex = (m_writeIndex + 1) % m_bufferSize;
+    m_buffer.Write(input + delayed * m_feedback);
 
     return delayed;
 }
 
 void FeedbackDelayLine::Clear() noexcept {
-    std::fill(m_buffer.begin(), m_buffer.end(), 0.0f);
-    m_writeIndex = 0;
+    m_buffer.Clear();
 }
@@ -3,10 +3,16 @@
 
 #pragma once
 
+#include "effects/util/DelayBuffer.hpp"
+#include "engine/ProcessSpec.hpp"
+
 #include <vector>
 #include <algorithm>
 
-// A single-channel delay line building block for different types of delay effects
+// A single-channel delay line building block for different types of delay effects.
+// The sample memory is owned by the effect using the line and attached with Attach(), so that it
+// can be allocated off the audio thread and only while the line is in use.
+// Delay time changes glide towards the new value (like a tape delay) instead of jumping the read head.
 class FeedbackDelayLine {
 public:
     // Constants for safety
@@ -17,12 +23,26 @@ public:
 
     FeedbackDelayLine(float delayTime, float feedback);
 
+    // Number of samples of memory that must be attached to serve delays up to MAX_DELAY_SEC
+    static size_t GetRequiredCapacity(float sampleRate);
+
+    // Not while memory is attached, since the required capacity changes with it
+    void SetSampleRate(float sampleRate) noexcept;
+
+    // Starts using the given memory (of GetRequiredCapacity() samples at the current rate, cleared) as sample history
+    void Attach(float *memory) noexcept;
+
+    // Stops using the attached memory. The line outputs silence until memory is attached again.
+    void Detach() noexcept;
+
     // Adjust delay time (seconds), safely clamped to allowed range
     void SetDelayTime(float seconds) noexcept;
 
     // Adjust feedback amount [0.0, 0.99]
     void SetFeedback(float fb) noexcept;
 
+    void SetInterpolation(DelayInterpolation::Type interpolation) noexcept;
+
     // Process one input sample and return the delayed output (without the input signal)
     float Process(float input) noexcept;
 
@@ -30,13 +50,20 @@ public:
     void Clear() noexcept;
 
 private:
-    // Initialize internal buffer based on sample rate and max delay
-    void Init();
-
-    std::vector<float> m_buffer;
-    size_t m_bufferSize   = 0;
-    size_t m_writeIndex   = 0;
-    size_t m_delaySamples = 0;
-    
+    // Moves the current delay one sample closer to the target delay
+    void StepDelaySmoothing() noexcept;
+
+    DelayBuffer m_buffer;
+    DelayInterpolation::Type m_interpolation = DelayInterpolation::Type::Lagrange;
+    float m_sampleRate = ProcessSpec::DEFAULT_SAMPLE_RATE;
+    float m_delaySeconds = MIN_DELAY_SEC;
+    float m_targetDelaySamples  = 0.0f;
+    float m_currentDelaySamples = 0.0f;
+
     float m_feedback   = 0.5f;
+
+    // The rate at which the current delay approaches the target delay per sample
+    static inline const float s_smoothingAlpha = 0.0005f;
+    // Below this distance (in samples) the glide snaps to the target and stops
+    static inline const float s_snapThreshold = 0.001f;
 };
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "effects/util/HalfBandFilter.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace {
+    // Accumulators in the dot product. Independent partial sums let the compiler use SIMD
+    // registers without reordering a single floating-point sum.
+    constexpr size_t s_numLanes = 4;
+
+    // Kaiser window shape, gives around 80 dB of stopband attenuation
+    constexpr double s_kaiserBeta = 8.0;
+
+    // Zeroth order modified Bessel function of the first kind, needed for the Kaiser window
+    double BesselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50; k++) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12) {
+                break;
+            }
+        }
+        return sum;
+    }
+}
+
+HalfBandFilter::HalfBandFilter(size_t halfLength)
+    : m_halfLength(halfLength)
+    , m_coeffs(2 * halfLength)
+    , m_upLeft(2 * halfLength)
+    , m_upRight(2 * halfLength)
+    , m_downEvenLeft(2 * halfLength)
+    , m_downEvenRight(2 * halfLength)
+    , m_downOddLeft(2 * halfLength)
+    , m_downOddRight(2 * halfLength)
+{
+    assert(halfLength > 0 && (2 * halfLength) % s_numLanes == 0 && "Unsupported half-band filter length.");
+
+    // Kaiser windowed sinc with cutoff at a quarter of the (higher) sample rate.
+    // The full kernel has 4 * halfLength - 1 taps with the centre tap at index 2 * halfLength - 1,
+    // the non-trivial branch is made up of the even-indexed taps.
+    const double numTaps = 4.0 * halfLength - 1.0;
+    const double centre = 2.0 * halfLength - 1.0;
+    const double windowNorm = BesselI0(s_kaiserBeta);
+    double sum = 0.0;
+    for (size_t j = 0; j < m_coeffs.size(); j++) {
+        double k = 2.0 * j;
+        double distance = (k - centre) / 2.0; // Always a half-integer, so the sinc is never 0/0
+        double sinc = std::sin(std::numbers::pi * distance) / (std::numbers::pi * distance);
+        double ratio = 2.0 * k / (numTaps - 1.0) - 1.0;
+        double window = BesselI0(s_kaiserBeta * std::sqrt(1.0 - ratio * ratio)) / windowNorm;
+        m_coeffs[j] = static_cast<float>(sinc * window);
+        sum += sinc * window;
+    }
+
+    // Normalize so a constant signal passes through the branch unchanged
+    for (float& coeff : m_coeffs) {
+        coeff = static_cast<float>(coeff / sum);
+    }
+}
+
+void HalfBandFilter::Upsample(const AudioFrame& input, AudioFrame *output) noexcept {
+    m_upLeft.Push(input.left);
+    m_upRight.Push(input.right);
+
+    const size_t length = m_coeffs.size();
+    const float *left = m_upLeft.GetWindow();
+    const float *right = m_upRight.GetWindow();
+
+    // Filtering the zero-stuffed signal: the first output comes from the FIR branch and
+    // the second one from the centre tap, which only delays the input
+    output[0] = { DotProduct(m_coeffs.data(), left, length), DotProduct(m_coeffs.data(), right, length) };
+    output[1] = { left[m_halfLength], right[m_halfLength] };
+}
+
+AudioFrame HalfBandFilter::Downsample(const AudioFrame *input) noexcept {
+    m_downEvenLeft.Push(input[0].left);
+    m_downEvenRight.Push(input[0].right);
+    m_downOddLeft.Push(input[1].left);
+    m_downOddRight.Push(input[1].right);
+
+    const size_t length = m_coeffs.size();
+    const float *oddLeft = m_downOddLeft.GetWindow();
+    const float *oddRight = m_downOddRight.GetWindow();
+
+    // Only every other output is computed, which is the whole point of the polyphase form
+    float left = DotProduct(m_coeffs.data(), m_downEvenLeft.GetWindow(), length) + oddLeft[m_halfLength - 1];
+    float right = DotProduct(m_coeffs.data(), m_downEvenRight.GetWindow(), length) + oddRight[m_halfLength - 1];
+    return { 0.5f * left, 0.5f * right };
+}
+
+float HalfBandFilter::GetLatency() const noexcept {
+    // Each of the two filters delays by its centre tap, counted at the higher rate
+    return static_cast<float>(2 * m_halfLength - 1);
+}
+
+void HalfBandFilter::Reset() noexcept {
+    m_upLeft.Clear();
+    m_upRight.Clear();
+    m_downEvenLeft.Clear();
+    m_downEvenRight.Clear();
+    m_downOddLeft.Clear();
+    m_downOddRight.Clear();
+}
+
+float HalfBandFilter::DotProduct(const float *a, const float *b, size_t length) noexcept {
+    float acc[s_numLanes] = {};
+    for (size_t i = 0; i < length; i += s_numLanes) {
+        for (size_t lane = 0; lane < s_numLanes; lane++) {
+            acc[lane] += a[i + lane] * b[i + lane];
+        }
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+HalfBandFilter::History::History(size_t length)
+    : m_data(2 * length, 0.0f)
+{}
+
+void HalfBandFilter::History::Push(float sample) noexcept {
+    size_t length = GetLength();
+    m_data[m_writeIndex] = sample;
+    m_data[m_writeIndex + length] = sample;
+    m_writeIndex = m_writeIndex + 1 == length ? 0 : m_writeIndex + 1;
+}
+
+const float *HalfBandFilter::History::GetWindow() const noexcept {
+    // The oldest sample is the one that will be overwritten next
+    return m_data.data() + m_writeIndex;
+}
+
+size_t HalfBandFilter::History::GetLength() const noexcept {
+    return m_data.size() / 2;
+}
+
+void HalfBandFilter::History::Clear() noexcept {
+    std::fill(m_data.begin(), m_data.end(), 0.0f);
+    m_writeIndex = 0;
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "engine/AudioFrame.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// One stereo 2x stage of an oversampler: a linear-phase half-band FIR filter split into
+// its two polyphase branches, used both for upsampling (before) and downsampling (after)
+// the oversampled processing.
+// Every other tap of a half-band filter is zero and the centre tap is 0.5, so one branch is
+// a pure delay and only the other branch needs a dot product per input frame.
+// The channels are kept in separate contiguous histories so the dot products vectorize.
+class HalfBandFilter {
+public:
+    // halfLength controls the steepness of the filter: the non-trivial branch has 2 * halfLength taps.
+    // Must be a multiple of 2.
+    explicit HalfBandFilter(size_t halfLength);
+
+    // Turns one frame into two frames at twice the sample rate
+    void Upsample(const AudioFrame& input, AudioFrame *output) noexcept;
+
+    // Turns two frames into one frame at half the sample rate
+    AudioFrame Downsample(const AudioFrame *input) noexcept;
+
+    // Delay added by upsampling followed by downsampling, in samples at the lower rate
+    float GetLatency() const noexcept;
+
+    void Reset() noexcept;
+
+private:
+    // Sample history for one channel. Every sample is written twice, so the most recent
+    // samples can always be read as one contiguous window without wrapping.
+    class History {
+    public:
+        explicit History(size_t length);
+
+        void Push(float sample) noexcept;
+
+        // The last GetLength() samples, oldest first
+        const float *GetWindow() const noexcept;
+        size_t GetLength() const noexcept;
+
+        void Clear() noexcept;
+
+    private:
+        std::vector<float> m_data;
+        size_t m_writeIndex = 0;
+    };
+
+    static float DotProduct(const float *a, const float *b, size_t length) noexcept;
+
+    size_t m_halfLength;
+
+    // Taps of the non-trivial branch, scaled to unity gain. Symmetric, so the order
+    // in which they are applied to the history doesn't matter.
+    std::vector<float> m_coeffs;
+
+    History m_upLeft;
+    History m_upRight;
+    History m_downEvenLeft;
+    History m_downEvenRight;
+    History m_downOddLeft;
+    History m_downOddRight;
+};
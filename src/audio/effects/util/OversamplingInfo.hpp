@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+namespace OversamplingInfo {
+    // Each step doubles the rate, so the value is also the number of 2x stages used
+    enum class Factor {
+        x2 = 1,
+        x4 = 2,
+        x8 = 3
+    };
+
+    inline constexpr const char* Names[] = { "2x", "4x", "8x" };
+}
@@ -4,6 +4,12 @@
 #include <stdio.h>
 #include <memory>
 #include <unordered_set>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <string_view>
 
 #include "engine/AudioBackend.hpp"
 #include "engine/AudioEngine.hpp"
@@ -11,6 +17,20 @@
 #include "preset/AudioPreset.hpp"
 #include "portaudio.h"
 
+namespace {
+    // Case-insensitive, so "alsa" finds "ALSA"
+    bool ContainsIgnoringCase(std::string_view text, std::string_view part) {
+        auto it = std::search(text.begin(), text.end(), part.begin(), part.end(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+        return it != text.end() || part.empty();
+    }
+
+    bool IsStereoOutput(const PaDeviceInfo *info) {
+        return info != NULL && info->maxOutputChannels >= 2;
+    }
+}
+
 AudioBackend::AudioBackend(AudioEngine *engine)
     : stream(0)
     , m_engine(engine)
@@ -18,7 +38,70 @@ AudioBackend::AudioBackend(AudioEngine *engine)
     // sprintf( message, "No Message" );
 }
 
-bool AudioBackend::open(PaDeviceIndex index)
+PaDeviceIndex AudioBackend::FindOutputDevice(const AudioDeviceSettings& settings)
+{
+    PaHostApiIndex hostApi = Pa_GetDefaultHostApi();
+    if (!settings.hostApi.empty()) {
+        hostApi = 0;
+        while (hostApi < Pa_GetHostApiCount() && !ContainsIgnoringCase(Pa_GetHostApiInfo(hostApi)->name, settings.hostApi)) {
+            hostApi++;
+        }
+        if (hostApi >= Pa_GetHostApiCount()) {
+            std::cerr << "No host API matches '" << settings.hostApi << "'" << std::endl;
+            return paNoDevice;
+        }
+    }
+    if (hostApi < 0) {
+        return paNoDevice;
+    }
+
+    if (settings.device.empty()) {
+        return Pa_GetHostApiInfo(hostApi)->defaultOutputDevice;
+    }
+
+    // An index as listed by PrintOutputDevices(), which already implies the host API
+    const std::string& device = settings.device;
+    PaDeviceIndex index = paNoDevice;
+    auto [end, error] = std::from_chars(device.data(), device.data() + device.size(), index);
+    if (error == std::errc() && end == device.data() + device.size()) {
+        if (index >= 0 && index < Pa_GetDeviceCount() && IsStereoOutput(Pa_GetDeviceInfo(index))) {
+            return index;
+        }
+        std::cerr << "No stereo output device has index " << device << std::endl;
+        return paNoDevice;
+    }
+
+    for (PaDeviceIndex i = 0; i < Pa_GetDeviceCount(); i++) {
+        const PaDeviceInfo *info = Pa_GetDeviceInfo(i);
+        if (IsStereoOutput(info) && info->hostApi == hostApi && ContainsIgnoringCase(info->name, device)) {
+            return i;
+        }
+    }
+    std::cerr << "No stereo output device of " << Pa_GetHostApiInfo(hostApi)->name
+              << " matches '" << device << "'" << std::endl;
+    return paNoDevice;
+}
+
+void AudioBackend::PrintOutputDevices()
+{
+    for (PaHostApiIndex hostApi = 0; hostApi < Pa_GetHostApiCount(); hostApi++) {
+        const PaHostApiInfo *hostInfo = Pa_GetHostApiInfo(hostApi);
+        std::cout << hostInfo->name << (hostApi == Pa_GetDefaultHostApi() ? " (default)" : "") << std::endl;
+
+        for (PaDeviceIndex i = 0; i < Pa_GetDeviceCount(); i++) {
+            const PaDeviceInfo *info = Pa_GetDeviceInfo(i);
+            if (!IsStereoOutput(info) || info->hostApi != hostApi) {
+                continue;
+            }
+            std::cout << "  " << i << ": " << info->name
+                      << (i == hostInfo->defaultOutputDevice ? " (default)" : "")
+                      << ", " << info->defaultSampleRate << " Hz, "
+                      << info->defaultLowOutputLatency * 1000.0 << " ms low latency" << std::endl;
+        }
+    }
+}
+
+bool AudioBackend::open(PaDeviceIndex index, const AudioDeviceSettings& settings)
 {
     PaStreamParameters outputParameters;
 
@@ -28,22 +111,23 @@ bool AudioBackend::open(PaDeviceIndex index)
     }
 
     const PaDeviceInfo* pInfo = Pa_GetDeviceInfo(index);
-    if (pInfo != 0)
-    {
-        // printf("Output device name: '%s'\r", pInfo->name);
+    if (pInfo == NULL) {
+        return false;
     }
 
     outputParameters.channelCount = 2;       /* stereo output */
     outputParameters.sampleFormat = paFloat32; /* 32 bit floating point output */
-    outputParameters.suggestedLatency = Pa_GetDeviceInfo( outputParameters.device )->defaultLowOutputLatency;
+    outputParameters.suggestedLatency = settings.latencyMs > 0.0
+        ? settings.latencyMs / 1000.0
+        : pInfo->defaultLowOutputLatency;
     outputParameters.hostApiSpecificStreamInfo = NULL;
 
     PaError err = Pa_OpenStream(
         &stream,
         NULL, /* no input */
         &outputParameters,
-        SAMPLE_RATE,
-        paFramesPerBufferUnspecified,
+        pInfo->defaultSampleRate,
+        settings.framesPerBuffer > 0 ? static_cast<unsigned long>(settings.framesPerBuffer) : paFramesPerBufferUnspecified,
         paClipOff,      /* we won't output out of range samples so don't bother clipping them */
         &AudioBackend::paCallback,
         this            /* Using 'this' for userData so we can cast to Sine* in paCallback method */
@@ -52,6 +136,8 @@ bool AudioBackend::open(PaDeviceIndex index)
     if (err != paNoError)
     {
         /* Failed to open stream to device !!! */
+        std::cerr << "Couldn't open " << pInfo->name << ": " << Pa_GetErrorText( err ) << std::endl;
+        stream = 0;
         return false;
     }
 
@@ -85,11 +171,64 @@ bool AudioBackend::start()
     if (stream == 0)
         return false;
 
+    // A new start may come with a new callback thread
+    m_isCallbackThreadTuned = false;
+    m_hasTuningResults.store(false, std::memory_order_relaxed);
+    m_isTuningReported = false;
+
     PaError err = Pa_StartStream( stream );
 
     return (err == paNoError);
 }
 
+void AudioBackend::SetRealtimeSettings(const RealtimeSettings& settings)
+{
+    m_realtime = settings;
+}
+
+void AudioBackend::TuneCallbackThread() noexcept
+{
+    ThreadTuning::ThreadHandle thread = ThreadTuning::GetCurrentThread();
+    if (m_realtime.realtimePriority) {
+        m_priorityResult = ThreadTuning::SetRealtimePriority(thread, m_realtime.priority);
+    }
+    if (m_realtime.audioCore >= 0) {
+        m_affinityResult = ThreadTuning::PinToCore(thread, m_realtime.audioCore);
+    }
+    if (m_realtime.lockMemory) {
+        ThreadTuning::PrefaultStack();
+    }
+    m_hasTuningResults.store(true, std::memory_order_release);
+}
+
+void AudioBackend::ReportCallbackThreadTuning()
+{
+    if (m_isTuningReported || !m_hasTuningResults.load(std::memory_order_acquire)) {
+        return;
+    }
+    m_isTuningReported = true;
+
+    if (m_realtime.realtimePriority) {
+        ThreadTuning::Report("Real-time priority of the audio callback", m_priorityResult);
+    }
+    if (m_realtime.audioCore >= 0) {
+        std::string what = "Pinning the audio callback to core " + std::to_string(m_realtime.audioCore);
+        ThreadTuning::Report(what.c_str(), m_affinityResult);
+    }
+}
+
+double AudioBackend::GetSampleRate() const
+{
+    const PaStreamInfo *info = stream ? Pa_GetStreamInfo( stream ) : NULL;
+    return info ? info->sampleRate : 0.0;
+}
+
+double AudioBackend::GetOutputLatency() const
+{
+    const PaStreamInfo *info = stream ? Pa_GetStreamInfo( stream ) : NULL;
+    return info ? info->outputLatency : 0.0;
+}
+
 bool AudioBackend::stop()
 {
     if (stream == 0)
@@ -105,11 +244,18 @@ int AudioBackend::paCallbackMethod(const void *inputBuffer, void *outputBuffer,
     const PaStreamCallbackTimeInfo* timeInfo,
     PaStreamCallbackFlags statusFlags) {
     (void)inputBuffer;
-    (void)timeInfo;
     (void)statusFlags;
 
+    if (!m_isCallbackThreadTuned) {
+        TuneCallbackThread();
+        m_isCallbackThreadTuned = true;
+    }
+
+    // Some host APIs don't report the DAC time, in which case it's zero
+    double outputDelay = std::max(timeInfo->outputBufferDacTime - timeInfo->currentTime, 0.0);
+
     // Process the entire audio graph
-    AudioBuffer buffer = m_engine->ProcessBuffer(framesPerBuffer);
+    const AudioBuffer& buffer = m_engine->ProcessBuffer(framesPerBuffer, outputDelay);
 
     // Copy result back to output buffer
     float *out = (float*)outputBuffer;
@@ -8,12 +8,16 @@
 #include <memory>
 #include <vector>
 #include <unordered_set>
+#include <atomic>
 #include <cassert>
 #include <numbers>
 
 #include "core/Frequency.hpp"
 #include "preset/AudioPreset.hpp"
 #include "engine/AudioFrame.hpp"
+#include "engine/AudioDeviceSettings.hpp"
+#include "system/RealtimeSettings.hpp"
+#include "system/ThreadTuning.hpp"
 #include "portaudio.h"
 
 // Forward declaration
@@ -25,6 +29,12 @@ struct AudioBuffer {
 
     AudioBuffer(size_t numFrames) : outputBuffer(numFrames), numFrames(numFrames) {}
 
+    // Makes it numFrames of silence. Only allocates when it never held as many frames before.
+    void Reset(size_t frames) {
+        outputBuffer.assign(frames, AudioFrame());
+        numFrames = frames;
+    }
+
     AudioBuffer(float *initBuffer, size_t numFrames)
         : outputBuffer(numFrames)
         , numFrames(numFrames)
@@ -62,11 +72,34 @@ class AudioBackend {
 public:
     AudioBackend(AudioEngine *engine);
 
-    bool open(PaDeviceIndex index);
+    // The output device the settings ask for, or paNoDevice (after saying why) if there is none.
+    // PortAudio must be initialised.
+    static PaDeviceIndex FindOutputDevice(const AudioDeviceSettings& settings);
+
+    // Prints every stereo output device, by host API, with the index to select it by
+    static void PrintOutputDevices();
+
+    // Opens the device at its default sample rate, with the buffer size and latency of the settings
+    bool open(PaDeviceIndex index, const AudioDeviceSettings& settings = {});
     bool close();
     bool start();
     bool stop();
 
+    // The rate of the open stream, as granted by the device
+    double GetSampleRate() const;
+
+    // The latency of the open stream in seconds, as the host reports it. Usually rounded up
+    // from the suggested latency to what the device and buffer size allow.
+    double GetOutputLatency() const;
+
+    // The callback thread belongs to the host API, so it tunes itself the first time it runs.
+    // Set before start().
+    void SetRealtimeSettings(const RealtimeSettings& settings);
+
+    // Prints how tuning the callback thread went, once it has happened. Call regularly from
+    // another thread; it prints only once per start().
+    void ReportCallbackThreadTuning();
+
 private:
     /* The instance callback, where we have access to every method/variable in object of class Sine */
     int paCallbackMethod(const void *inputBuffer, void *outputBuffer,
@@ -85,6 +118,9 @@ private:
         void *userData );
 
 
+    // On the callback thread
+    void TuneCallbackThread() noexcept;
+
     void paStreamFinishedMethod();
 
     /*
@@ -98,4 +134,11 @@ private:
     // Saw lfo;
     char message[200];
     AudioEngine *m_engine;
+
+    RealtimeSettings m_realtime;
+    bool m_isCallbackThreadTuned = false; // Callback thread only, while the stream runs
+    ThreadTuning::Result m_priorityResult;
+    ThreadTuning::Result m_affinityResult;
+    std::atomic<bool> m_hasTuningResults = false;
+    bool m_isTuningReported = false;
 };
\ No newline at end of file
@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// How to open the audio output. The defaults leave every choice to PortAudio and the device,
+// which is what to tune when trading latency against CPU load on a particular machine.
+struct AudioDeviceSettings {
+    std::string hostApi;        // Part of a host API name (like "ALSA" or "WASAPI"), empty for the default
+    std::string device;         // Part of an output device name or its index, empty for the host API's default
+    size_t framesPerBuffer = 0; // 0 lets the host choose, which may then vary from callback to callback
+    double latencyMs = 0.0;     // Suggested output latency, 0 for the device's default low latency
+};
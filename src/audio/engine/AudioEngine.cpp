@@ -9,6 +9,9 @@
 #include <cassert>
 #include <thread>
 #include <unordered_set>
+#include <algorithm>
+#include <chrono>
+#include <string>
 
 #include "portaudio.h"
 #include "engine/AudioEngine.hpp"
@@ -24,38 +27,161 @@
 #include "effects/HighPassFilter.hpp"
 #include "effects/FeedbackDelay.hpp"
 #include "effects/Reverb.hpp"
+#include "system/ThreadTuning.hpp"
 
-AudioEngine::AudioEngine(std::shared_ptr<AudioPreset> preset, std::shared_ptr<FFTComputer> fftComputer)
-    : m_preset(preset)
+AudioEngine::AudioEngine(std::vector<std::shared_ptr<PresetPublisher>> partPresets, std::shared_ptr<PartRoutingTable> routing,
+                         std::shared_ptr<FFTComputer> fftComputer, std::shared_ptr<EngineEventQueue> events)
+    : m_routing(routing)
     , m_fftComputer(fftComputer)
+    , m_events(events)
     , m_backend(this)
+    , m_pool(std::min<size_t>(partPresets.size(), std::max(1u, std::thread::hardware_concurrency())) - 1)
+    , m_partRoutings(partPresets.size())
+{
+    assert(partPresets.size() == routing->GetNumParts() && "Every part needs a routing.");
+
+    m_parts.reserve(partPresets.size());
+    for (const std::shared_ptr<PresetPublisher>& presets : partPresets) {
+        m_parts.push_back(std::make_unique<SynthPart>(presets));
+    }
+    m_activeParts.reserve(m_parts.size());
+    m_output.outputBuffer.reserve(m_spec.maxBlockSize);
+}
+
+AudioEngine::AudioEngine(std::shared_ptr<PresetPublisher> presets, std::shared_ptr<FFTComputer> fftComputer,
+                         std::shared_ptr<EngineEventQueue> events)
+    : AudioEngine(std::vector { presets }, std::make_shared<PartRoutingTable>(1), fftComputer, events)
 {}
 
-// Recurse from the root of the graph
-AudioBuffer AudioEngine::ProcessBuffer(size_t numFrames) {
-    std::shared_ptr<AudioProcessor> rootNode = m_synthLayout.GetRootNode();
-    if (!rootNode) {
-        // Empty processing graph, so provide empty audio
-        return AudioBuffer(numFrames);
+void AudioEngine::Prepare(float sampleRate, size_t maxBlockSize) {
+    m_spec.sampleRate = sampleRate;
+    m_spec.maxBlockSize = maxBlockSize;
+
+    for (const std::unique_ptr<SynthPart>& part : m_parts) {
+        part->Prepare(m_spec);
+    }
+    m_output.outputBuffer.reserve(maxBlockSize);
+    m_fftComputer->SetSampleRate(sampleRate);
+}
+
+float AudioEngine::GetSampleRate() const {
+    return m_spec.sampleRate;
+}
+
+void AudioEngine::SetRenderPath(RenderPath path) {
+    for (const std::unique_ptr<SynthPart>& part : m_parts) {
+        part->SetRenderPath(path);
     }
+}
+
+const AudioBuffer& AudioEngine::ProcessBuffer(size_t numFrames, double outputDelay) {
+    CollectEvents(numFrames, outputDelay);
+    UpdateRouting();
+    RouteEvents(numFrames);
 
-    m_synthLayout.LoadPreset(*m_preset);
+    // The parts share nothing, so each renders on whichever thread gets to it first
+    auto renderPart = [&](size_t i) {
+        m_parts[m_activeParts[i]]->Render(numFrames);
+    };
+    m_pool.Run(m_activeParts.size(), renderPart);
 
-    AudioBuffer result(numFrames);
-    for (size_t i = 0; i < numFrames; i++) {
-        rootNode->ClearVisited();
-        rootNode->ClearModulations();
-        m_synthLayout.ApplyAllModulations();
-        result.outputBuffer[i] = rootNode->GenerateFrame(*m_preset);
+    // Hosts may hand over a larger buffer than prepared for, which is the only time this allocates
+    m_output.Reset(numFrames);
+    int latencySamples = 0;
+    for (size_t part : m_activeParts) {
+        const AudioBuffer& output = m_parts[part]->GetOutput();
+        for (size_t i = 0; i < numFrames; i++) {
+            m_output.outputBuffer[i] += output.outputBuffer[i];
+        }
+        latencySamples = std::max(latencySamples, m_parts[part]->GetLatencySamples());
     }
+    m_latencySamples.store(latencySamples, std::memory_order_relaxed);
 
     // Send buffer to FFT thread
-    m_fftComputer->ProvideAudioBuffer(result);
+    m_fftComputer->ProvideAudioBuffer(m_output);
     
-    return result;
+    return m_output;
 }
 
-void AudioEngine::Start(std::atomic<bool>& running) {
+void AudioEngine::UpdateRouting() {
+    m_activeParts.clear();
+    for (size_t part = 0; part < m_parts.size(); part++) {
+        PartRouting routing = m_routing->Get(part);
+        if (m_partRoutings[part].isOn && !routing.isOn) {
+            // Notes still held would otherwise sound again when the part is turned back on
+            m_parts[part]->ReleaseAllNotes();
+        }
+        m_partRoutings[part] = routing;
+
+        if (routing.isOn) {
+            m_activeParts.push_back(part);
+        }
+    }
+}
+
+void AudioEngine::RouteEvents(size_t numFrames) {
+    size_t numRouted = 0;
+    for (; numRouted < m_numPendingEvents && m_pendingEvents[numRouted].sampleOffset < numFrames; numRouted++) {
+        const EngineEvent& event = m_pendingEvents[numRouted];
+        for (size_t part : m_activeParts) {
+            const PartRouting& routing = m_partRoutings[part];
+            if (!routing.IsOnChannel(event.channel)) {
+                continue;
+            }
+            // Note offs ignore the key range, so a note never hangs if the range changes while it's held
+            if (event.type == EngineEvent::Type::NoteOn && !routing.IsInRange(event.note)) {
+                continue;
+            }
+            m_parts[part]->AddEvent(event);
+        }
+    }
+
+    // The rest belong to later buffers
+    std::copy(m_pendingEvents.begin() + numRouted, m_pendingEvents.begin() + m_numPendingEvents, m_pendingEvents.begin());
+    m_numPendingEvents -= numRouted;
+    for (size_t i = 0; i < m_numPendingEvents; i++) {
+        m_pendingEvents[i].sampleOffset -= static_cast<uint32_t>(numFrames);
+    }
+}
+
+void AudioEngine::CollectEvents(size_t numFrames, double outputDelay) {
+    // Live events that arrived during the last buffer period are laid out over this buffer with
+    // the same relative timing. Every note is thereby delayed by exactly one buffer period,
+    // instead of by anything between zero and one depending on when in the period it came.
+    const EngineEvent::Clock::time_point now = EngineEvent::Clock::now();
+    const double sampleRate = m_spec.sampleRate;
+    const std::chrono::duration<double> bufferDuration(static_cast<double>(numFrames) / sampleRate);
+    const EngineEvent::Clock::time_point periodStart =
+        now - std::chrono::duration_cast<EngineEvent::Clock::duration>(bufferDuration);
+    const double graphLatency = static_cast<double>(m_latencySamples.load(std::memory_order_relaxed)) / sampleRate;
+
+    EngineEvent event;
+    while (m_numPendingEvents < m_pendingEvents.size() && m_events->Pop(event)) {
+        if (event.isTimestamped) {
+            // Events from before the period (e.g. after the GUI stalled) play right away
+            double secondsIntoPeriod = std::chrono::duration<double>(event.time - periodStart).count();
+            size_t frame = static_cast<size_t>(std::max(secondsIntoPeriod, 0.0) * sampleRate);
+            event.sampleOffset = static_cast<uint32_t>(std::min(frame, numFrames > 0 ? numFrames - 1 : 0));
+
+            if (event.type == EngineEvent::Type::NoteOn) {
+                // From the key press until the note's first frame comes out of the audio device
+                double waited = std::chrono::duration<double>(now - event.time).count();
+                double latency = waited + static_cast<double>(event.sampleOffset) / sampleRate + outputDelay + graphLatency;
+                m_events->ReportLatency(static_cast<float>(latency * 1000.0));
+            }
+        }
+
+        // Insertion sort, keeping events with the same offset in the order they were sent
+        size_t i = m_numPendingEvents++;
+        for (; i > 0 && m_pendingEvents[i - 1].sampleOffset > event.sampleOffset; i--) {
+            m_pendingEvents[i] = m_pendingEvents[i - 1];
+        }
+        m_pendingEvents[i] = event;
+    }
+}
+
+void AudioEngine::Start(std::atomic<bool>& running, const AudioDeviceSettings& deviceSettings,
+                        const RealtimeSettings& realtime) {
     ScopedPaHandler paInit;
     if (paInit.result() != paNoError) {
         std::cerr << "An error occurred while using the portaudio stream\n";
@@ -63,16 +189,97 @@ void AudioEngine::Start(std::atomic<bool>& running) {
         std::cerr << "Error message: %s\n" << Pa_GetErrorText( paInit.result() );
     }
 
-    if (m_backend.open(Pa_GetDefaultOutputDevice())) {
+    // Build the graph for the preset loaded at startup before the first buffer
+    ManageGraphs();
+
+    PaDeviceIndex device = AudioBackend::FindOutputDevice(deviceSettings);
+    if (m_backend.open(device, deviceSettings)) {
+        // The stream runs at the device's own rate, so the OS doesn't resample, and the graph follows it.
+        // With a fixed buffer size no block is ever larger.
+        size_t maxBlockSize = deviceSettings.framesPerBuffer > 0 ? deviceSettings.framesPerBuffer : ProcessSpec::DEFAULT_MAX_BLOCK_SIZE;
+        Prepare(static_cast<float>(m_backend.GetSampleRate()), maxBlockSize);
+        ManageGraphs();
+
+        OutputStreamInfo streamInfo;
+        streamInfo.sampleRate = GetSampleRate();
+        streamInfo.latencyMs = static_cast<float>(m_backend.GetOutputLatency() * 1000.0);
+        streamInfo.framesPerBuffer = static_cast<uint32_t>(deviceSettings.framesPerBuffer);
+        m_events->ReportOutputStream(streamInfo);
+
+        const PaDeviceInfo *deviceInfo = Pa_GetDeviceInfo(device);
+        std::cout << "Audio output: " << deviceInfo->name << " (" << Pa_GetHostApiInfo(deviceInfo->hostApi)->name << "), "
+                  << streamInfo.sampleRate << " Hz, "
+                  << (streamInfo.framesPerBuffer > 0 ? std::to_string(streamInfo.framesPerBuffer) : "variable") << " frames per buffer, "
+                  << streamInfo.latencyMs << " ms output latency" << std::endl;
+
+        TuneWorkers(realtime);
+        m_backend.SetRealtimeSettings(realtime);
+
         if (m_backend.start()) {
             while (running.load()) {
+                m_backend.ReportCallbackThreadTuning();
+                ManageGraphs();
                 Pa_Sleep(50); // Sleep 50ms
             }
             m_backend.stop();
         }
         
         m_backend.close();
+        m_events->ReportOutputStream({});
         printf("Audio stopped.\n");
     }
     m_fftComputer->FinishedProducing();
 }
+
+void AudioEngine::TuneWorkers(const RealtimeSettings& realtime) {
+    const size_t numWorkers = m_pool.GetNumThreads() - 1;
+    if (numWorkers == 0) {
+        return;
+    }
+
+    // Reported once for all of them, with the first failure if any
+    ThreadTuning::Result priorityResult;
+    ThreadTuning::Result affinityResult;
+    for (size_t worker = 0; worker < numWorkers; worker++) {
+        ThreadTuning::ThreadHandle thread = m_pool.GetWorkerHandle(worker);
+        if (realtime.realtimePriority && priorityResult.error == 0) {
+            priorityResult = ThreadTuning::SetRealtimePriority(thread, realtime.priority);
+        }
+        if (realtime.audioCore >= 0 && affinityResult.error == 0) {
+            affinityResult = ThreadTuning::PinAwayFromCore(thread, realtime.audioCore);
+        }
+    }
+
+    if (realtime.realtimePriority) {
+        ThreadTuning::Report("Real-time priority of the render workers", priorityResult);
+    }
+    if (realtime.audioCore >= 0) {
+        ThreadTuning::Report("Keeping the render workers off the audio core", affinityResult);
+    }
+}
+
+void AudioEngine::ManageGraphs() {
+    for (const std::unique_ptr<SynthPart>& part : m_parts) {
+        part->ManageGraphs();
+    }
+}
+
+std::vector<NodeMemoryUsage> AudioEngine::GetMemoryReport() const {
+    // Every part has the same nodes, in the same order
+    std::vector<NodeMemoryUsage> report;
+    for (const std::unique_ptr<SynthPart>& part : m_parts) {
+        std::vector<NodeMemoryUsage> partReport = part->GetMemoryReport();
+        if (report.empty()) {
+            report = std::move(partReport);
+            continue;
+        }
+        for (size_t i = 0; i < report.size() && i < partReport.size(); i++) {
+            report[i].bytes += partReport[i].bytes;
+        }
+    }
+    return report;
+}
+
+int AudioEngine::GetLatencySamples() const {
+    return m_latencySamples.load(std::memory_order_relaxed);
+}
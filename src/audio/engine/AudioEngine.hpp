@@ -3,29 +3,106 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "engine/AudioBackend.hpp"
+#include "engine/AudioDeviceSettings.hpp"
+#include "system/RealtimeSettings.hpp"
 #include "preset/AudioPreset.hpp"
+#include "preset/PresetPublisher.hpp"
 #include "engine/AudioProcessor.hpp"
 #include "fft/FFTComputer.hpp"
+#include "engine/EngineEventQueue.hpp"
+#include "engine/PartRouting.hpp"
+#include "engine/ProcessSpec.hpp"
+#include "engine/SynthPart.hpp"
 #include "layout/AudioLayout.hpp"
-#include "layout/SynthLayout.hpp"
-
-#define SAMPLE_RATE (44100)
+#include "synchronization/WorkStealingPool.hpp"
 
 class AudioEngine {
 public:
-    AudioEngine(std::shared_ptr<AudioPreset> preset, std::shared_ptr<FFTComputer> fftComputer);
+    // One part per preset publisher, routed by the table, which must have as many parts
+    AudioEngine(std::vector<std::shared_ptr<PresetPublisher>> partPresets, std::shared_ptr<PartRoutingTable> routing,
+                std::shared_ptr<FFTComputer> fftComputer, std::shared_ptr<EngineEventQueue> events);
+
+    // A single part that plays everything
+    AudioEngine(std::shared_ptr<PresetPublisher> presets, std::shared_ptr<FFTComputer> fftComputer,
+                std::shared_ptr<EngineEventQueue> events);
+
+    // Sets the sample rate and the largest buffer size to render for, and prepares every part for
+    // them. Not while audio is being rendered: Start() calls it once the stream is open, offline
+    // renders call it before the first ProcessBuffer(). Until then, the defaults of ProcessSpec apply.
+    void Prepare(float sampleRate, size_t maxBlockSize);
+
+    float GetSampleRate() const;
+
+    // How every part renders its graph, the static chain unless set. Not while audio is being
+    // rendered, like Prepare().
+    void SetRenderPath(RenderPath path);
 
-    // Recurse from the root of the tree
-    AudioBuffer ProcessBuffer(size_t numFrames);
+    // Renders every part that is on, in parallel, and sums them.
+    // outputDelay is the time in seconds until the first frame reaches the audio device.
+    // The result stays valid until the next call.
+    const AudioBuffer& ProcessBuffer(size_t numFrames, double outputDelay);
 
-    void Start(std::atomic<bool>& running);
+    // Plays through the output device chosen by the settings until running turns false.
+    // The real-time settings apply to the audio callback and the render workers.
+    void Start(std::atomic<bool>& running, const AudioDeviceSettings& deviceSettings = {},
+               const RealtimeSettings& realtime = {});
+
+    // Housekeeping for every part: builds graphs for preset switches, frees retired ones,
+    // and manages the resources of all of them. Start() runs it between buffers; when rendering
+    // offline without an audio device, call it between calls to ProcessBuffer instead.
+    void ManageGraphs();
+
+    // Heap memory currently held by each node of the synth, summed over all parts and their live graphs
+    std::vector<NodeMemoryUsage> GetMemoryReport() const;
+
+    // Delay added by the processing graph (e.g. by oversampling), in samples
+    int GetLatencySamples() const;
 private:
-    std::shared_ptr<AudioPreset> m_preset;
+    // Gives the render workers the same priority as the audio callback that waits for them,
+    // and keeps them off its core
+    void TuneWorkers(const RealtimeSettings& realtime);
+
+    // Takes the events that arrived since the last buffer, turns timestamps into frame offsets,
+    // and sorts them in with the events still pending from earlier buffers
+    void CollectEvents(size_t numFrames, double outputDelay);
+
+    // Reads the routing of every part for this buffer, and lists the parts that are on
+    void UpdateRouting();
+
+    // Hands the events that fall within this buffer to the parts listening for them
+    void RouteEvents(size_t numFrames);
+
+    // Far more than anyone can press within one audio buffer. Any extra wait in the queue.
+    static constexpr size_t s_maxPendingEvents = SynthPart::MAX_EVENTS_PER_BUFFER;
+
+    std::shared_ptr<PartRoutingTable> m_routing;
     std::shared_ptr<FFTComputer> m_fftComputer;
+    std::shared_ptr<EngineEventQueue> m_events;
     AudioBackend m_backend;
-    SynthLayout m_synthLayout;
+
+    std::vector<std::unique_ptr<SynthPart>> m_parts;
+    ProcessSpec m_spec;
+
+    // Renders the parts. A thread per part at most, counting the audio thread itself.
+    WorkStealingPool m_pool;
+
+    // --- Audio thread ---
+
+    std::vector<PartRouting> m_partRoutings; // As of the start of the current buffer
+    std::vector<size_t> m_activeParts;       // Reserved for every part, so it never allocates
+    AudioBuffer m_output { 0 };              // Reserved for the largest buffer
+
+    // Measured on the audio thread every buffer
+    std::atomic<int> m_latencySamples { 0 };
+
+    // Events not yet applied, ordered by their frame offset from the start of the current buffer
+    std::array<EngineEvent, s_maxPendingEvents> m_pendingEvents;
+    size_t m_numPendingEvents = 0;
 };
\ No newline at end of file
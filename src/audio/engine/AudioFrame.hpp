@@ -3,18 +3,36 @@
 
 #pragma once
 
+#include <algorithm>
+
 struct AudioFrame {
     float left = 0.0f;
     float right = 0.0f;
 
     // Clamp the amplitude to avoid the possibility of going deaf
-    void ClipToValidRange();
+    void ClipToValidRange() noexcept {
+        left = std::clamp(left, -1.0f, 1.0f);
+        right = std::clamp(right, -1.0f, 1.0f);
+    }
+
+    // How much of each signal Blend() keeps for a given mix
+    struct BlendGains {
+        float dry = 1.0f;
+        float wet = 0.0f;
+    };
+    static BlendGains GetBlendGains(float mix) noexcept;
 
     // Blend between processed and unprocessed signals.
     // mix = 0 -> fully unprocessed
     // mix = 1 -> fully processed
     static AudioFrame Blend(const AudioFrame& processed, const AudioFrame& unprocessed, float mix) noexcept;
 
+    // The same, with the gains worked out beforehand, for when the mix stays put over many frames
+    static constexpr AudioFrame Blend(const AudioFrame& processed, const AudioFrame& unprocessed, BlendGains gains) noexcept {
+        return { processed.left * gains.wet + unprocessed.left * gains.dry,
+                 processed.right * gains.wet + unprocessed.right * gains.dry };
+    }
+
     constexpr AudioFrame operator+(const AudioFrame& other) const noexcept {
         return { left + other.left, right + other.right };
     }
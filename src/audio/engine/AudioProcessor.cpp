@@ -5,6 +5,7 @@
 #include "engine/AudioEngine.hpp"
 #include "engine/AudioBackend.hpp"
 #include "modulation/LFO.hpp"
+#include <algorithm>
 #include <iostream>
 
 void AudioProcessor::AddChild(std::shared_ptr<AudioProcessor> child) {
@@ -61,6 +62,36 @@ void AudioProcessor::ClearVisited() {
     }
 }
 
+void AudioProcessor::SyncResources() {
+    SyncResourcesImpl();
+    for (const std::shared_ptr<AudioProcessor>& child : m_children) {
+        child->SyncResources();
+    }
+}
+
+void AudioProcessor::ManageResources() {
+    ManageResourcesImpl();
+    for (const std::shared_ptr<AudioProcessor>& child : m_children) {
+        child->ManageResources();
+    }
+}
+
+void AudioProcessor::Prepare(const ProcessSpec& spec) {
+    m_spec = spec;
+    PrepareImpl();
+    for (const std::shared_ptr<AudioProcessor>& child : m_children) {
+        child->Prepare(spec);
+    }
+}
+
+float AudioProcessor::GetTotalLatencySamples() const {
+    float childLatency = 0.0f;
+    for (const std::shared_ptr<AudioProcessor>& child : m_children) {
+        childLatency = std::max(childLatency, child->GetTotalLatencySamples());
+    }
+    return childLatency + (isOn ? GetLatencySamples() : 0.0f);
+}
+
 void AudioProcessor::ApplyGainAndPan(AudioFrame& output) {
     output = gain.Apply(output);
     output = pan.Apply(output);
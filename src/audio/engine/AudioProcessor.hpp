@@ -11,6 +11,7 @@
 
 #include "core/Frequency.hpp"
 #include "engine/AudioBackend.hpp"
+#include "engine/ProcessSpec.hpp"
 #include "modulation/LFO.hpp"
 #include "core/Gain.hpp"
 #include "core/Pan.hpp"
@@ -33,6 +34,34 @@ public:
     virtual void ProcessFrame(AudioFrame& output) = 0;
     void ClearVisited();
 
+    // Called once per buffer on the audio thread so nodes can start or stop using memory
+    // that ManageResources() has prepared. Must never allocate or free.
+    void SyncResources();
+    virtual void SyncResourcesImpl() {};
+
+    // Called regularly from a non-real-time thread so nodes can allocate or free the memory they need
+    void ManageResources();
+    virtual void ManageResourcesImpl() {};
+
+    // Called off the audio thread, while this graph isn't rendering, whenever the sample rate or
+    // buffer size changes. Nodes recompute whatever depends on them; memory sized by them is
+    // replaced through ManageResources() afterwards.
+    void Prepare(const ProcessSpec& spec);
+    virtual void PrepareImpl() {};
+
+    const ProcessSpec& GetProcessSpec() const { return m_spec; }
+    float GetSampleRate() const { return m_spec.sampleRate; }
+
+    // Returns the heap memory held by this node (not including its children), in bytes.
+    // Safe to call from any thread.
+    virtual size_t GetMemoryUsage() const { return 0; }
+
+    // Delay this node adds to the signal when it's on, in samples (may be fractional)
+    virtual float GetLatencySamples() const { return 0.0f; }
+
+    // Delay of the slowest path from the leaves up to and including this node. Audio thread only.
+    float GetTotalLatencySamples() const;
+
     Gain gain;
     Pan pan;
     bool isOn = true;
@@ -41,6 +70,7 @@ public:
 private:
     void ApplyGainAndPan(AudioFrame& frame); 
 
+    ProcessSpec m_spec;
     bool m_visited = false;
     AudioFrame m_cachedResult;
 
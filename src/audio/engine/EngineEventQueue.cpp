@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "engine/EngineEventQueue.hpp"
+
+bool EngineEventQueue::NoteOn(Note note, float velocity, uint32_t sampleOffset, uint8_t channel) {
+    EngineEvent event;
+    event.type = EngineEvent::Type::NoteOn;
+    event.note = note;
+    event.velocity = velocity;
+    event.sampleOffset = sampleOffset;
+    event.channel = channel;
+    return Push(event);
+}
+
+bool EngineEventQueue::NoteOff(Note note, uint32_t sampleOffset, uint8_t channel) {
+    EngineEvent event;
+    event.type = EngineEvent::Type::NoteOff;
+    event.note = note;
+    event.sampleOffset = sampleOffset;
+    event.channel = channel;
+    return Push(event);
+}
+
+bool EngineEventQueue::SetParameter(ParameterInfo::ID parameter, float value, uint32_t sampleOffset, uint8_t channel) {
+    EngineEvent event;
+    event.type = EngineEvent::Type::ParameterChange;
+    event.parameter = parameter;
+    event.value = value;
+    event.sampleOffset = sampleOffset;
+    event.channel = channel;
+    return Push(event);
+}
+
+bool EngineEventQueue::NoteOnNow(Note note, float velocity, uint8_t channel) {
+    EngineEvent event;
+    event.type = EngineEvent::Type::NoteOn;
+    event.note = note;
+    event.velocity = velocity;
+    event.isTimestamped = true;
+    event.time = EngineEvent::Clock::now();
+    event.channel = channel;
+    return Push(event);
+}
+
+bool EngineEventQueue::NoteOffNow(Note note, uint8_t channel) {
+    EngineEvent event;
+    event.type = EngineEvent::Type::NoteOff;
+    event.note = note;
+    event.isTimestamped = true;
+    event.time = EngineEvent::Clock::now();
+    event.channel = channel;
+    return Push(event);
+}
+
+float EngineEventQueue::GetLastLatencyMs() const noexcept {
+    return m_lastLatencyMs.load(std::memory_order_relaxed);
+}
+
+float EngineEventQueue::GetMaxLatencyMs() const noexcept {
+    return m_maxLatencyMs.load(std::memory_order_relaxed);
+}
+
+OutputStreamInfo EngineEventQueue::GetOutputStreamInfo() const noexcept {
+    OutputStreamInfo info;
+    info.sampleRate = m_streamSampleRate.load(std::memory_order_relaxed);
+    info.latencyMs = m_streamLatencyMs.load(std::memory_order_relaxed);
+    info.framesPerBuffer = m_streamFramesPerBuffer.load(std::memory_order_relaxed);
+    return info;
+}
+
+bool EngineEventQueue::Pop(EngineEvent& event) noexcept {
+    return m_events.Pop(event);
+}
+
+void EngineEventQueue::ReportLatency(float latencyMs) noexcept {
+    m_lastLatencyMs.store(latencyMs, std::memory_order_relaxed);
+    // Only the audio thread writes, so a plain compare is enough
+    if (latencyMs > m_maxLatencyMs.load(std::memory_order_relaxed)) {
+        m_maxLatencyMs.store(latencyMs, std::memory_order_relaxed);
+    }
+}
+
+void EngineEventQueue::ReportOutputStream(const OutputStreamInfo& info) noexcept {
+    m_streamSampleRate.store(info.sampleRate, std::memory_order_relaxed);
+    m_streamLatencyMs.store(info.latencyMs, std::memory_order_relaxed);
+    m_streamFramesPerBuffer.store(info.framesPerBuffer, std::memory_order_relaxed);
+}
+
+bool EngineEventQueue::Push(const EngineEvent& event) {
+    return m_events.Push(event);
+}
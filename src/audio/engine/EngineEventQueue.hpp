@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "core/Frequency.hpp"
+#include "preset/AudioPreset.hpp"
+#include "synchronization/SPSCRingBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Something the engine should do at a specific frame
+struct EngineEvent {
+    using Clock = std::chrono::steady_clock;
+
+    enum class Type {
+        NoteOn,
+        NoteOff,
+        ParameterChange
+    };
+
+    Type type = Type::NoteOn;
+
+    Note note { Key::A };  // NoteOn, NoteOff
+    float velocity = 1.0f; // NoteOn, in the range [0, 1]
+
+    ParameterInfo::ID parameter = ParameterInfo::ID::MasterVolume; // ParameterChange
+    float value = 0.0f;                                            // ParameterChange
+
+    // Like a MIDI channel. Each part of the engine only listens to its own (see PartRouting).
+    uint8_t channel = 0;
+
+    // When to apply the event: a frame offset from the start of the next block the engine renders
+    // (it may lie in a later block), or for live input the time it happened, which the engine
+    // turns into an offset itself
+    uint32_t sampleOffset = 0;
+    bool isTimestamped = false;
+    Clock::time_point time;
+};
+
+// What the audio device granted when the stream was opened
+struct OutputStreamInfo {
+    float sampleRate = 0.0f;      // 0 while no stream is open
+    float latencyMs = 0.0f;       // As reported by the host
+    uint32_t framesPerBuffer = 0; // 0 if the host chooses per callback
+};
+
+// Carries events to the audio thread through a fixed-size lock-free queue, and the measured
+// key-to-sound latency of live notes and the output stream's settings back. There must be only one thread pushing events.
+// The engine splits each block at the event offsets, so the timing is sample accurate no matter
+// the buffer size.
+class EngineEventQueue {
+public:
+    // --- Event producer thread ---
+
+    // Each returns false if the queue is full
+    bool NoteOn(Note note, float velocity, uint32_t sampleOffset, uint8_t channel = 0);
+    bool NoteOff(Note note, uint32_t sampleOffset, uint8_t channel = 0);
+    // The change lasts until the next preset snapshot is published
+    bool SetParameter(ParameterInfo::ID parameter, float value, uint32_t sampleOffset, uint8_t channel = 0);
+
+    // For live input. Timestamped with the current time.
+    bool NoteOnNow(Note note, float velocity, uint8_t channel = 0);
+    bool NoteOffNow(Note note, uint8_t channel = 0);
+
+    // Time from a live key press until its note reaches the audio device, in milliseconds
+    float GetLastLatencyMs() const noexcept;
+    float GetMaxLatencyMs() const noexcept;
+
+    OutputStreamInfo GetOutputStreamInfo() const noexcept;
+
+    // --- Audio thread ---
+
+    bool Pop(EngineEvent& event) noexcept;
+
+    void ReportLatency(float latencyMs) noexcept;
+
+    // When a stream is opened, or with the defaults when it closes
+    void ReportOutputStream(const OutputStreamInfo& info) noexcept;
+
+private:
+    bool Push(const EngineEvent& event);
+
+    // Far more than anyone can press within one audio buffer
+    static constexpr size_t s_queueCapacity = 1024;
+
+    SPSCRingBuffer<EngineEvent> m_events { s_queueCapacity };
+
+    std::atomic<float> m_lastLatencyMs = 0.0f;
+    std::atomic<float> m_maxLatencyMs = 0.0f;
+
+    // Only for display, so the fields don't need to change together
+    std::atomic<float> m_streamSampleRate = 0.0f;
+    std::atomic<float> m_streamLatencyMs = 0.0f;
+    std::atomic<uint32_t> m_streamFramesPerBuffer = 0;
+};
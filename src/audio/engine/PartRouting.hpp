@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "engine/EngineEventQueue.hpp"
+
+// Which notes a part of the engine plays: those sent on its channel, within its key range.
+// Parts with overlapping ranges layer, parts with adjacent ranges split the keyboard.
+struct alignas(4) PartRouting {
+    static constexpr uint8_t ANY_CHANNEL = 0xff;
+
+    bool isOn = false;
+    uint8_t channel = ANY_CHANNEL;
+    // Note::GetIndex() of the lowest and highest keys played
+    uint8_t lowestKey = 0;
+    uint8_t highestKey = 0xff;
+
+    bool IsOnChannel(uint8_t eventChannel) const noexcept {
+        return channel == ANY_CHANNEL || channel == eventChannel;
+    }
+
+    bool IsInRange(Note note) const noexcept {
+        int index = note.GetIndex();
+        return index >= lowestKey && index <= highestKey;
+    }
+};
+
+// The routing of every part, set from the GUI thread and read by the audio thread at the start
+// of every buffer. A routing is small enough to be swapped as a single word, so it's always
+// read whole.
+class PartRoutingTable {
+public:
+    // The first part is on for every key, the rest start off
+    explicit PartRoutingTable(size_t numParts)
+        : m_numParts(numParts)
+        , m_routings(std::make_unique<std::atomic<PartRouting>[]>(numParts))
+    {
+        static_assert(std::atomic<PartRouting>::is_always_lock_free);
+        assert(numParts > 0 && "There must be at least one part.");
+        PartRouting first;
+        first.isOn = true;
+        Set(0, first);
+    }
+
+    size_t GetNumParts() const noexcept { return m_numParts; }
+
+    PartRouting Get(size_t part) const noexcept { return m_routings[part].load(std::memory_order_relaxed); }
+    void Set(size_t part, PartRouting routing) noexcept { m_routings[part].store(routing, std::memory_order_relaxed); }
+
+private:
+    size_t m_numParts;
+    std::unique_ptr<std::atomic<PartRouting>[]> m_routings;
+};
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <cstddef>
+
+// What the engine renders for. Chosen when the audio stream opens (or per offline render) and
+// handed down the graph by AudioProcessor::Prepare(), so nodes never assume a fixed rate.
+struct ProcessSpec {
+    static constexpr float DEFAULT_SAMPLE_RATE = 44100.0f;
+    static constexpr size_t DEFAULT_MAX_BLOCK_SIZE = 4096;
+
+    float sampleRate = DEFAULT_SAMPLE_RATE;
+    size_t maxBlockSize = DEFAULT_MAX_BLOCK_SIZE; // Most frames rendered in one buffer
+
+    bool operator==(const ProcessSpec& other) const = default;
+};
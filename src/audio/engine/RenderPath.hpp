@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+// How the engine runs the synth graph of each part. Both sound exactly the same.
+enum class RenderPath {
+    Graph,       // Node by node through the AudioProcessor tree, like any layout
+    StaticChain, // Through the layout's chain of the same nodes, composed at compile time (faster)
+};
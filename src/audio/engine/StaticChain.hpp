@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "engine/AudioFrame.hpp"
+#include "engine/AudioProcessor.hpp"
+
+// A chain of nodes wired up at compile time: the first NumSources nodes are summed, and the sum
+// runs through the rest in order. It renders exactly what the same nodes would as a graph of
+// AudioProcessors, but a block at a time in a single loop, with every call made on the concrete
+// node type. That skips the tree walks, the visited bookkeeping and the virtual calls that
+// GenerateFrame() costs per node and frame, and works out the dry/wet gains once per block.
+//
+// The chain only refers to the nodes, which stay owned (and wired into their graph) by whoever
+// built them. They may be reconfigured between blocks, but isOn and mix must hold still within one.
+template <size_t NumSources, typename... Nodes>
+class StaticChain {
+    static_assert(NumSources > 0 && NumSources <= sizeof...(Nodes), "A chain needs at least one source");
+    static_assert((std::is_base_of_v<AudioProcessor, Nodes> && ...), "Every stage must be a node");
+    static_assert((std::is_final_v<Nodes> && ...), "Every stage must be final, so its calls resolve at compile time");
+
+public:
+    explicit StaticChain(Nodes&... nodes) : m_nodes(nodes...) {}
+
+    // Renders numFrames frames into output. beforeFrame() is called ahead of each frame, once the
+    // modulations of the last one have been cleared, to apply those of this one.
+    template <typename BeforeFrame>
+    void ProcessBlock(AudioFrame *output, size_t numFrames, BeforeFrame&& beforeFrame) {
+        ProcessBlock(output, numFrames, beforeFrame, std::index_sequence_for<Nodes...>());
+    }
+
+private:
+    template <typename BeforeFrame, size_t... I>
+    void ProcessBlock(AudioFrame *output, size_t numFrames, BeforeFrame& beforeFrame, std::index_sequence<I...>) {
+        const std::array<AudioFrame::BlendGains, sizeof...(Nodes)> gains {
+            AudioFrame::GetBlendGains(std::get<I>(m_nodes).mix)...
+        };
+
+        for (size_t i = 0; i < numFrames; i++) {
+            (std::get<I>(m_nodes).ClearModulationsImpl(), ...);
+            beforeFrame();
+
+            AudioFrame signal;
+            (RunStage<I>(signal, gains[I]), ...);
+            output[i] = signal;
+        }
+    }
+
+    // Sources add to the signal, the rest process it
+    template <size_t I>
+    void RunStage(AudioFrame& signal, AudioFrame::BlendGains gains) {
+        if constexpr (I < NumSources) {
+            signal += RunNode<I>(AudioFrame(), gains);
+        }else {
+            signal = RunNode<I>(signal, gains);
+        }
+    }
+
+    // The same steps as AudioProcessor::GenerateFrame(), given the sum of the node's children
+    template <size_t I>
+    AudioFrame RunNode(const AudioFrame& input, AudioFrame::BlendGains gains) {
+        auto& node = std::get<I>(m_nodes);
+        AudioFrame frame = input;
+        if (node.isOn) {
+            AudioFrame processed = input;
+            node.ProcessFrame(processed);
+            processed = node.gain.Apply(processed);
+            processed = node.pan.Apply(processed);
+            frame = AudioFrame::Blend(processed, input, gains);
+        }
+        frame.ClipToValidRange();
+        return frame;
+    }
+
+    std::tuple<Nodes&...> m_nodes;
+};
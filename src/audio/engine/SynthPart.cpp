@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "engine/SynthPart.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+SynthPart::SynthPart(std::shared_ptr<PresetPublisher> presets)
+    : m_presets(presets)
+    , m_graph(std::make_unique<PresetGraph>())
+    , m_liveGraphs { m_graph.get() }
+{
+    Prepare(m_spec);
+}
+
+void SynthPart::AddEvent(const EngineEvent& event) noexcept {
+    if (m_numEvents < m_events.size()) {
+        m_events[m_numEvents++] = event;
+    }
+}
+
+void SynthPart::Render(size_t numFrames) {
+    // Pick up the latest preset as a whole, with a single pointer swap
+    if (const PresetPublisher::Snapshot* snapshot = m_presets->Fetch()) {
+        m_heldSnapshot = snapshot;
+    }
+
+    StartCrossfade();
+
+    // Edits made after a switch wait until the graph built for it plays
+    if (m_heldSnapshot && m_heldSnapshot->generation <= m_graph->generation) {
+        m_preset.SetTarget(m_heldSnapshot->preset);
+        m_heldSnapshot = nullptr;
+    }
+
+    m_output.Reset(numFrames);
+
+    SynthLayout& layout = m_graph->layout;
+    std::shared_ptr<AudioProcessor> rootNode = layout.GetRootNode();
+    if (!rootNode) {
+        // Empty processing graph, so provide empty audio
+        m_numEvents = 0;
+        return;
+    }
+
+    // Pick up (or let go of) memory prepared by the housekeeping loop
+    rootNode->SyncResources();
+
+    m_latencySamples = static_cast<int>(std::lround(rootNode->GetTotalLatencySamples()));
+
+    // Render the buffer in segments split at the events, so each one lands on its exact frame
+    size_t frame = 0;
+    size_t nextEvent = 0;
+    while (frame < numFrames) {
+        for (; nextEvent < m_numEvents && m_events[nextEvent].sampleOffset <= frame; nextEvent++) {
+            ApplyEvent(m_events[nextEvent]);
+        }
+
+        size_t segmentEnd = numFrames;
+        if (nextEvent < m_numEvents) {
+            segmentEnd = std::min<size_t>(m_events[nextEvent].sampleOffset, numFrames);
+        }
+
+        // Glide the parameters across the segment. The layout only reconfigures the nodes
+        // whose parameters actually moved.
+        m_preset.Advance(static_cast<double>(segmentEnd - frame) / m_spec.sampleRate);
+        layout.LoadPreset(m_preset.GetCurrent());
+
+        RenderFrames(layout, m_preset.GetCurrent(), m_output, frame, segmentEnd);
+        frame = segmentEnd;
+    }
+    m_numEvents = 0;
+
+    RenderCrossfade(m_output);
+}
+
+void SynthPart::ReleaseAllNotes() {
+    m_graph->layout.ReleaseAllNotes();
+}
+
+const AudioBuffer& SynthPart::GetOutput() const noexcept {
+    return m_output;
+}
+
+int SynthPart::GetLatencySamples() const noexcept {
+    return m_latencySamples;
+}
+
+void SynthPart::StartCrossfade() {
+    if (m_fadingGraph) {
+        // Still fading, or the last graph is still waiting to be handed back
+        if (m_crossfadeFrame < m_crossfadeLength || !m_graphHandoff.TryRetire(m_fadingGraph)) {
+            return;
+        }
+    }
+
+    std::unique_ptr<PresetGraph> incoming;
+    if (!m_graphHandoff.TryAdopt(incoming)) {
+        return;
+    }
+
+    // Held notes carry on in the new graph, while the old one keeps playing under the fade so
+    // that its release and effect tails ring out
+    for (const auto& [note, velocity] : m_graph->layout.GetPressedNotes()) {
+        incoming->layout.NoteOn(note, velocity);
+    }
+    m_graph->layout.ReleaseAllNotes();
+    m_graph->preset = m_preset.GetCurrent();
+    m_fadingGraph = std::move(m_graph);
+    m_graph = std::move(incoming);
+    m_preset.Reset(m_graph->preset);
+
+    m_crossfadeFrame = 0;
+    m_crossfadeLength = static_cast<size_t>(s_crossfadeTime * m_spec.sampleRate);
+    m_crossfadeRenderSeconds = 0.0;
+}
+
+void SynthPart::RenderCrossfade(AudioBuffer& buffer) {
+    if (!m_fadingGraph || m_crossfadeFrame >= m_crossfadeLength) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::shared_ptr<AudioProcessor> fadingRoot = m_fadingGraph->layout.GetRootNode();
+    fadingRoot->SyncResources();
+
+    // No events reach the old graph, so it renders the whole buffer in one go
+    size_t numFrames = buffer.outputBuffer.size();
+    size_t fadeFrames = std::min(numFrames, m_crossfadeLength - m_crossfadeFrame);
+    m_fadingOutput.Reset(fadeFrames);
+    RenderFrames(m_fadingGraph->layout, m_fadingGraph->preset, m_fadingOutput, 0, fadeFrames);
+
+    for (size_t i = 0; i < fadeFrames; i++) {
+        float progress = static_cast<float>(m_crossfadeFrame + i) / static_cast<float>(m_crossfadeLength);
+        buffer.outputBuffer[i] = AudioFrame::Blend(buffer.outputBuffer[i], m_fadingOutput.outputBuffer[i], progress);
+    }
+    m_crossfadeFrame += fadeFrames;
+
+    m_crossfadeRenderSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (m_crossfadeFrame >= m_crossfadeLength) {
+        // Time spent on the old graph, relative to the real time the fade lasted
+        m_presets->ReportCrossfadeLoad(static_cast<float>(m_crossfadeRenderSeconds / s_crossfadeTime));
+        m_graphHandoff.TryRetire(m_fadingGraph);
+    }
+}
+
+void SynthPart::RenderFrames(SynthLayout& layout, const AudioPreset& preset, AudioBuffer& buffer, size_t begin, size_t end) {
+    if (m_renderPath == RenderPath::StaticChain) {
+        layout.RenderFrames(buffer.outputBuffer.data() + begin, end - begin);
+        return;
+    }
+
+    AudioProcessor& rootNode = *layout.GetRootNode();
+    for (size_t i = begin; i < end; i++) {
+        rootNode.ClearVisited();
+        rootNode.ClearModulations();
+        layout.ApplyAllModulations();
+        buffer.outputBuffer[i] = rootNode.GenerateFrame(preset);
+    }
+}
+
+void SynthPart::ApplyEvent(const EngineEvent& event) {
+    switch (event.type) {
+        case EngineEvent::Type::NoteOn:
+            m_graph->layout.NoteOn(event.note, event.velocity);
+            break;
+        case EngineEvent::Type::NoteOff:
+            m_graph->layout.NoteOff(event.note);
+            break;
+        case EngineEvent::Type::ParameterChange:
+            m_preset.SetTarget(event.parameter, event.value);
+            break;
+        default:
+            assert(false && "Unknown engine event type");
+            break;
+    }
+}
+
+void SynthPart::Prepare(const ProcessSpec& spec) {
+    std::lock_guard<std::mutex> lock(m_liveGraphsMutex);
+
+    m_spec = spec;
+    m_output.outputBuffer.reserve(spec.maxBlockSize);
+    m_fadingOutput.outputBuffer.reserve(spec.maxBlockSize);
+    for (PresetGraph* graph : m_liveGraphs) {
+        graph->layout.Prepare(spec);
+    }
+}
+
+void SynthPart::SetRenderPath(RenderPath path) noexcept {
+    m_renderPath = path;
+}
+
+void SynthPart::ManageGraphs() {
+    std::lock_guard<std::mutex> lock(m_liveGraphsMutex);
+
+    // Free the graph the audio thread faded out
+    if (std::unique_ptr<PresetGraph> retired = m_graphHandoff.CollectRetired()) {
+        std::erase(m_liveGraphs, retired.get());
+    }
+
+    // Build a graph for a newly loaded preset, fully configured and with its memory allocated,
+    // so the audio thread only has to start playing it
+    if (std::optional<PresetPublisher::Snapshot> next = m_presets->TakeSwitch()) {
+        auto graph = std::make_unique<PresetGraph>();
+        graph->preset = next->preset;
+        graph->generation = next->generation;
+        graph->layout.Prepare(m_spec);
+        graph->layout.LoadPreset(graph->preset);
+        graph->layout.GetRootNode()->ManageResources();
+        m_liveGraphs.push_back(graph.get());
+
+        // A graph for an even earlier switch that never got to play
+        if (std::unique_ptr<PresetGraph> unused = m_graphHandoff.Offer(std::move(graph))) {
+            std::erase(m_liveGraphs, unused.get());
+        }
+    }
+
+    // Allocate and free node memory here, where it can't stall the audio callback
+    for (PresetGraph* graph : m_liveGraphs) {
+        graph->layout.GetRootNode()->ManageResources();
+    }
+}
+
+std::vector<NodeMemoryUsage> SynthPart::GetMemoryReport() const {
+    std::lock_guard<std::mutex> lock(m_liveGraphsMutex);
+
+    // Every graph has the same nodes, in the same order
+    std::vector<NodeMemoryUsage> report;
+    for (const PresetGraph* graph : m_liveGraphs) {
+        std::vector<NodeMemoryUsage> graphReport = graph->layout.GetMemoryReport();
+        if (report.empty()) {
+            report = std::move(graphReport);
+            continue;
+        }
+        for (size_t i = 0; i < report.size() && i < graphReport.size(); i++) {
+            report[i].bytes += graphReport[i].bytes;
+        }
+    }
+    return report;
+}
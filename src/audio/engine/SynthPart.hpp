@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "engine/AudioBackend.hpp"
+#include "engine/EngineEventQueue.hpp"
+#include "engine/ProcessSpec.hpp"
+#include "engine/RenderPath.hpp"
+#include "layout/SynthLayout.hpp"
+#include "preset/AudioPreset.hpp"
+#include "preset/PresetPublisher.hpp"
+#include "preset/PresetSmoother.hpp"
+#include "synchronization/ResourceHandoff.hpp"
+
+// One independent instrument of the engine: a synth graph playing its own preset, published by
+// the GUI through its own PresetPublisher. Switching presets crossfades to a second graph built
+// off the audio thread. The engine renders its parts in parallel and sums them.
+class SynthPart {
+public:
+    explicit SynthPart(std::shared_ptr<PresetPublisher> presets);
+
+    // --- Audio thread (or a worker rendering for it) ---
+
+    // Queues an event for the next Render(), at its offset into the buffer.
+    // Events must be added in the order of their offsets.
+    void AddEvent(const EngineEvent& event) noexcept;
+
+    // Renders the next buffer, applying the queued events at their exact frames
+    void Render(size_t numFrames);
+
+    // Lets every held note ring out, for when the part stops receiving events
+    void ReleaseAllNotes();
+
+    // What the last Render() produced
+    const AudioBuffer& GetOutput() const noexcept;
+
+    // Delay added by the graph (e.g. by oversampling), in samples, as of the last Render()
+    int GetLatencySamples() const noexcept;
+
+    // --- Housekeeping thread ---
+
+    // Prepares every graph, and the ones built from now on, for the spec.
+    // Only while the part isn't rendering; the node memory is replaced by ManageGraphs().
+    void Prepare(const ProcessSpec& spec);
+
+    // Only while the part isn't rendering
+    void SetRenderPath(RenderPath path) noexcept;
+
+    // Builds graphs for preset switches, frees retired ones, and manages the resources of all of them
+    void ManageGraphs();
+
+    // Heap memory held by each node, summed over all live graphs
+    std::vector<NodeMemoryUsage> GetMemoryReport() const;
+
+    // Far more than anyone can press within one audio buffer
+    static constexpr size_t MAX_EVENTS_PER_BUFFER = 256;
+
+private:
+    // A synth graph along with the preset it was built for
+    struct PresetGraph {
+        SynthLayout layout;
+        AudioPreset preset;
+        uint64_t generation = 0; // See PresetPublisher::Snapshot
+    };
+
+    void ApplyEvent(const EngineEvent& event);
+
+    // Picks up a newly built graph and starts fading over to it, unless a fade is already running
+    void StartCrossfade();
+
+    // Renders the graph being faded out over the whole buffer and blends it in
+    void RenderCrossfade(AudioBuffer& buffer);
+
+    void RenderFrames(SynthLayout& layout, const AudioPreset& preset, AudioBuffer& buffer, size_t begin, size_t end);
+
+    // Long enough to hide the switch, short enough that the old graph costs little
+    static constexpr double s_crossfadeTime = 0.1;
+
+    std::shared_ptr<PresetPublisher> m_presets;
+    ProcessSpec m_spec;
+    RenderPath m_renderPath = RenderPath::StaticChain;
+
+    // --- Audio thread ---
+
+    std::unique_ptr<PresetGraph> m_graph;
+    // The previous graph while fading out, then until it could be handed back.
+    // At most one, so a switch never costs more than one extra graph.
+    std::unique_ptr<PresetGraph> m_fadingGraph;
+    size_t m_crossfadeFrame = 0;
+    size_t m_crossfadeLength = 0;
+    double m_crossfadeRenderSeconds = 0.0;
+
+    // Glides toward the latest published snapshot, plus any parameter events applied since
+    PresetSmoother m_preset;
+
+    // A snapshot made after a switch whose graph isn't playing yet
+    const PresetPublisher::Snapshot *m_heldSnapshot = nullptr;
+
+    std::array<EngineEvent, MAX_EVENTS_PER_BUFFER> m_events;
+    size_t m_numEvents = 0;
+
+    // Sized for the largest buffer up front, so rendering doesn't allocate
+    AudioBuffer m_output { 0 };
+    AudioBuffer m_fadingOutput { 0 };
+    int m_latencySamples = 0;
+
+    // --- Housekeeping thread ---
+
+    ResourceHandoff<PresetGraph> m_graphHandoff;
+
+    // Every graph that exists, whoever currently holds it. Only the housekeeping thread creates
+    // and frees graphs, so it can manage their resources without asking the audio thread.
+    std::vector<PresetGraph*> m_liveGraphs;
+    mutable std::mutex m_liveGraphsMutex; // For GetMemoryReport()
+};
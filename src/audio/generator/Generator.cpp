@@ -8,6 +8,5 @@ Generator::Generator() {
 }
 
 void Generator::ProcessFrame(AudioFrame& output) {
-    float value = m_headroom.Apply(GetNextSample());
-    output += value;
+    output += m_headroom.Apply(GetNextFrame());
 }
\ No newline at end of file
@@ -14,8 +14,8 @@ public:
 
     void ProcessFrame(AudioFrame& output) override;
 
-    // Computes the next sample in the signal to generate
-    virtual float GetNextSample() = 0;
+    // Computes the next frame in the signal to generate
+    virtual AudioFrame GetNextFrame() = 0;
 
 private:
     Gain m_headroom;
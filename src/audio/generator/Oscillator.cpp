@@ -2,24 +2,68 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "generator/Oscillator.hpp"
-#include "engine/AudioEngine.hpp"
 
-Voice::Voice(Note note, std::unique_ptr<Waveform> wf, const Envelope& env)
+#include <algorithm>
+
+Voice::Voice(Note note, std::unique_ptr<Waveform> wf, const Envelope& env, float velocity)
     : note(note)
     , freq(note)
     , m_wf(std::move(wf))
     , m_env(env)
+    , m_velocity(velocity)
 {}
 
-float Voice::GetNextSample() {
-    float dt = 1.0 / SAMPLE_RATE;
-    float dOffset = dt * freq.GetAbsolute();
-    m_currentPhase += dOffset;
+void Voice::RandomizePhases(std::mt19937& gen) {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (WaveformInfo::Lanes& phases : m_phases) {
+        for (float& phase : phases) {
+            phase = dist(gen);
+            phase -= static_cast<int>(phase); // Can round up to exactly 1
+        }
+    }
+}
+
+AudioFrame Voice::GetNextFrame(const Unison& unison, float sampleTime) {
+    float dOffset = sampleTime * freq.GetAbsolute();
+
+    // The pitch and envelope are per note; only the work below is per sub-voice, a lane block at a time
+    WaveformInfo::Lanes left {};
+    WaveformInfo::Lanes right {};
+    for (size_t block = 0; block < unison.GetNumBlocks(); block++) {
+        // Work on a local copy, which can't alias the other arrays, so the loops vectorize
+        WaveformInfo::Lanes phases = m_phases[block];
+        const WaveformInfo::Lanes& ratios = unison.GetPitchRatios(block);
+        for (size_t lane = 0; lane < WaveformInfo::LANE_WIDTH; lane++) {
+            // Detuned up, a sub-voice may pass the Nyquist frequency that freq is limited to
+            phases[lane] += std::min(dOffset * ratios[lane], 0.5f);
+
+            // Loop back to always be in range [0, 1]
+            phases[lane] -= static_cast<int>(phases[lane]);
+        }
+        m_phases[block] = phases;
 
-    // Loop back to always be in range [0, 1]
-    m_currentPhase -= static_cast<int>(m_currentPhase);
+        // Lanes without a sub-voice have no gain, but must not hold a NaN
+        WaveformInfo::Lanes samples {};
+        m_wf->GetSamplesAt(phases, samples, unison.GetNumVoicesInBlock(block));
 
-    return m_wf->GetSampleAt(m_currentPhase) * m_env.GetNextSample();
+        const WaveformInfo::Lanes& leftGains = unison.GetLeftGains(block);
+        const WaveformInfo::Lanes& rightGains = unison.GetRightGains(block);
+        for (size_t lane = 0; lane < WaveformInfo::LANE_WIDTH; lane++) {
+            left[lane] += samples[lane] * leftGains[lane];
+            right[lane] += samples[lane] * rightGains[lane];
+        }
+    }
+
+    AudioFrame frame;
+    for (size_t lane = 0; lane < WaveformInfo::LANE_WIDTH; lane++) {
+        frame.left += left[lane];
+        frame.right += right[lane];
+    }
+    return frame * m_env.GetNextSample() * m_velocity;
+}
+
+void Voice::SetSampleRate(float sampleRate) {
+    m_env.SetSampleRate(sampleRate);
 }
 
 void Voice::SetWaveformType(WaveformInfo::Type type) {
@@ -38,10 +82,14 @@ bool Voice::IsDead() const {
     return m_env.IsComplete();
 }
 
-void Oscillator::NoteOn(Note note) {
+void Oscillator::NoteOn(Note note, float velocity) {
     CleanUpDeadNotes(); // Regularly remove notes that have gone silent
 
-    Voice v(note, Waveform::ConstructWaveform(m_waveformType), m_env);
+    Voice v(note, Waveform::ConstructWaveform(m_waveformType), m_env, velocity);
+    v.SetOctave(m_octave);
+    if (m_unison.GetNumVoices() > 1) {
+        v.RandomizePhases(m_phaseGen); // A single voice starts at phase 0, so its attack is the same every time
+    }
     m_voices.push_back(std::move(v));
 }
 
@@ -68,14 +116,20 @@ void Oscillator::SetWaveformType(WaveformInfo::Type type) {
 // Update the envelope used for note volume
 void Oscillator::SetEnvelope(Envelope envelope) {
     m_env = envelope;
+    m_env.SetSampleRate(GetSampleRate());
 }
 
 void Oscillator::SetOctave(int octave) {
+    m_octave = octave;
     for (auto& voice : m_voices) {
         voice.SetOctave(octave);
     }
 }
 
+void Oscillator::SetUnison(int numVoices, float detuneCents, float spread) {
+    m_unison.Set(numVoices, detuneCents, spread);
+}
+
 void Oscillator::ApplyModulation(float amount, ModulationType modType) {
     if (modType == ModulationType::Pitch) {
         // Modulates the pitch of all voices
@@ -97,12 +151,20 @@ void Oscillator::ClearModulationsImpl() {
     pan.ClearModulations();
 }
 
-float Oscillator::GetNextSample() {
-    float sample = 0.0f;
+AudioFrame Oscillator::GetNextFrame() {
+    AudioFrame frame;
+    for (auto& voice : m_voices) {
+        frame += voice.GetNextFrame(m_unison, m_sampleTime);
+    }
+    return frame;
+}
+
+void Oscillator::PrepareImpl() {
+    m_sampleTime = 1.0 / GetSampleRate();
+    m_env.SetSampleRate(GetSampleRate());
     for (auto& voice : m_voices) {
-        sample += voice.GetNextSample();
+        voice.SetSampleRate(GetSampleRate());
     }
-    return sample;
 }
 
 void Oscillator::CleanUpDeadNotes() {
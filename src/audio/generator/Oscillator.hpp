@@ -5,16 +5,26 @@
 
 #include "core/Frequency.hpp"
 #include "Generator.hpp"
+#include "generator/Unison.hpp"
 #include "core/Waveform.hpp"
 #include "modulation/Envelope.hpp"
 #include "modulation/LFO.hpp"
 
+#include <array>
+#include <random>
 #include <vector>
 
+// One played note, with a phase for each of its unison sub-voices
 class Voice {
 public:
-    Voice(Note note, std::unique_ptr<Waveform> wf, const Envelope& env);
-    float GetNextSample();
+    Voice(Note note, std::unique_ptr<Waveform> wf, const Envelope& env, float velocity = 1.0f);
+
+    // Gives the sub-voices random phases, so they don't all start in phase and sound like one loud voice
+    void RandomizePhases(std::mt19937& gen);
+
+    // sampleTime is the length of a sample in seconds
+    AudioFrame GetNextFrame(const Unison& unison, float sampleTime);
+    void SetSampleRate(float sampleRate);
     void SetWaveformType(WaveformInfo::Type type);
     void SetOctave(int octave);
     void Release(); // Tells the envelope to go into "release" state to fade out the note
@@ -25,15 +35,16 @@ public:
 private:
     std::unique_ptr<Waveform> m_wf;
     Envelope m_env;
-    float m_currentPhase = 0.0f;
+    float m_velocity; // Scales the whole voice
+    std::array<WaveformInfo::Lanes, Unison::MAX_BLOCKS> m_phases {}; // In range [0, 1)
 };
 
 class Oscillator final : public Generator {
 public:
-    explicit Oscillator(WaveformInfo::Type type = WaveformInfo::Type::Saw) : m_waveformType(type) {}
+    explicit Oscillator(WaveformInfo::Type type = WaveformInfo::Type::Saw) : m_waveformType(type), m_phaseGen(1337) {}
 
-    // Start a new voice
-    void NoteOn(Note note);
+    // Start a new voice. The velocity in the range [0, 1] scales its volume.
+    void NoteOn(Note note, float velocity = 1.0f);
 
     // Stop an existing voice
     void NoteOff(Note note);
@@ -47,14 +58,19 @@ public:
     // Updates the octave used for the root note A5 at 440Hz (5 is default, per definition)
     void SetOctave(int octave);
 
+    // Updates the unison sub-voices (see Unison), also for the notes already playing
+    void SetUnison(int numVoices, float detuneCents, float spread);
+
     void ApplyModulation(float amount, ModulationType modType) override;
 
     // Clears all modulations accumulated from LFOs in the last frame so they can modulate the next one
     virtual void ClearModulationsImpl() override;
 
-    // Returns the next sample for this oscillator. Must be called once every frame or it will become desynched.
-    float GetNextSample() override;
-    
+    // Returns the next frame for this oscillator. Must be called once every frame or it will become desynched.
+    AudioFrame GetNextFrame() override;
+
+    void PrepareImpl() override;
+
 private:
     // Remove voices lazily which allows them to play the "release" of a note
     void CleanUpDeadNotes();
@@ -62,5 +78,8 @@ private:
     WaveformInfo::Type m_waveformType;
     Envelope m_env;
     std::vector<Voice> m_voices;
-    int octave = 5;
+    int m_octave = 5;
+    float m_sampleTime = 1.0 / ProcessSpec::DEFAULT_SAMPLE_RATE; // Seconds per sample
+    Unison m_unison;
+    std::mt19937 m_phaseGen; // Fixed seed, so renders are repeatable
 };
\ No newline at end of file
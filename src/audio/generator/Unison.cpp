@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "generator/Unison.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void Unison::Set(int numVoices, float detuneCents, float spread) {
+    numVoices = std::clamp(numVoices, 1, MAX_VOICES);
+    if (numVoices == m_numVoices && detuneCents == m_detuneCents && spread == m_spread) {
+        return;
+    }
+    m_numVoices = numVoices;
+    m_numBlocks = (static_cast<size_t>(numVoices) + WaveformInfo::LANE_WIDTH - 1) / WaveformInfo::LANE_WIDTH;
+    m_detuneCents = detuneCents;
+    m_spread = spread;
+
+    // Keep the overall level about the same however many sub-voices there are
+    float level = 1.0f / std::sqrt(static_cast<float>(numVoices));
+
+    for (int voice = 0; voice < MAX_VOICES; voice++) {
+        size_t block = voice / WaveformInfo::LANE_WIDTH;
+        size_t lane = voice % WaveformInfo::LANE_WIDTH;
+
+        if (voice >= numVoices) {
+            m_pitchRatios[block][lane] = 1.0f;
+            m_leftGains[block][lane] = 0.0f;
+            m_rightGains[block][lane] = 0.0f;
+            continue;
+        }
+
+        // Evenly from -1 to 1, a single sub-voice sits in the middle
+        float position = numVoices > 1 ? 2.0f * voice / (numVoices - 1) - 1.0f : 0.0f;
+        m_pitchRatios[block][lane] = std::pow(2.0f, position * detuneCents / 1200.0f);
+
+        // The same pan law as Pan, so a centered sub-voice plays at full level on both sides
+        float pan = 0.5f + 0.5f * position * spread;
+        m_leftGains[block][lane] = level * std::min(1.0f - pan, 0.5f) * 2.0f;
+        m_rightGains[block][lane] = level * std::min(pan, 0.5f) * 2.0f;
+    }
+}
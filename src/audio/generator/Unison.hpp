@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "core/Waveform.hpp"
+
+// How an oscillator spreads each note over several slightly detuned copies of itself (sub-voices),
+// panned across the stereo field, like a supersaw. The sub-voices of a note are rendered together
+// in blocks of WaveformInfo::LANE_WIDTH lanes, so up to 8 of them cost about as much as one.
+class Unison {
+public:
+    static constexpr int MAX_VOICES = 16;
+    static constexpr size_t MAX_BLOCKS = MAX_VOICES / WaveformInfo::LANE_WIDTH;
+
+    Unison() { Set(1, 0.0f, 0.0f); }
+
+    // detuneCents is how far the outermost sub-voices are tuned from the note, up and down.
+    // spread in [0, 1] pans them apart, from all centered to the outermost fully left and right.
+    void Set(int numVoices, float detuneCents, float spread);
+
+    int GetNumVoices() const noexcept { return m_numVoices; }
+
+    // Lane blocks holding at least one sub-voice
+    size_t GetNumBlocks() const noexcept { return m_numBlocks; }
+
+    // Lanes of the block holding a sub-voice, always the first ones
+    size_t GetNumVoicesInBlock(size_t block) const noexcept {
+        return std::min(static_cast<size_t>(m_numVoices) - block * WaveformInfo::LANE_WIDTH, WaveformInfo::LANE_WIDTH);
+    }
+
+    // Frequency of each sub-voice relative to the note, in lane blocks
+    const WaveformInfo::Lanes& GetPitchRatios(size_t block) const noexcept { return m_pitchRatios[block]; }
+
+    // Level of each sub-voice per channel. Lanes without a sub-voice are silent.
+    const WaveformInfo::Lanes& GetLeftGains(size_t block) const noexcept { return m_leftGains[block]; }
+    const WaveformInfo::Lanes& GetRightGains(size_t block) const noexcept { return m_rightGains[block]; }
+
+private:
+    int m_numVoices = 0;
+    size_t m_numBlocks = 0;
+    float m_detuneCents = 0.0f;
+    float m_spread = 0.0f;
+
+    std::array<WaveformInfo::Lanes, MAX_BLOCKS> m_pitchRatios {};
+    std::array<WaveformInfo::Lanes, MAX_BLOCKS> m_leftGains {};
+    std::array<WaveformInfo::Lanes, MAX_BLOCKS> m_rightGains {};
+};
@@ -5,7 +5,16 @@
 
 #include "engine/AudioProcessor.hpp"
 #include "preset/AudioPreset.hpp"
+#include "core/Frequency.hpp"
 #include <memory>
+#include <string>
+#include <vector>
+
+// Heap memory held by one node of a layout
+struct NodeMemoryUsage {
+    std::string name;
+    size_t bytes;
+};
 
 // Represents an audio processing graph along with a modulation matrix.
 // The audio layout specifies the oscillators, effect chains, audio+modulation
@@ -13,7 +22,7 @@
 class AudioLayout {
 public:
     virtual std::shared_ptr<AudioProcessor> GetRootNode() = 0;
-    virtual void LoadPreset(AudioPreset& preset) = 0;
+    virtual void LoadPreset(const AudioPreset& preset) = 0;
     void ClearAllModulations() {
         auto root = GetRootNode();
         if (root) {
@@ -21,4 +30,24 @@ public:
         }
     }
     virtual void ApplyAllModulations() {}
+
+    // Called on the audio thread at the exact frame a note starts or stops.
+    // The velocity is in the range [0, 1].
+    virtual void NoteOn(Note note, float velocity) { (void)note; (void)velocity; }
+    virtual void NoteOff(Note note) { (void)note; }
+
+    // Releases every held note, letting them ring out
+    virtual void ReleaseAllNotes() {}
+
+    // Prepares the graph, and whatever else of the layout depends on the sample rate,
+    // for the spec (see AudioProcessor::Prepare)
+    virtual void Prepare(const ProcessSpec& spec) {
+        auto root = GetRootNode();
+        if (root) {
+            root->Prepare(spec);
+        }
+    }
+
+    // Per-node memory usage, safe to call from any thread
+    virtual std::vector<NodeMemoryUsage> GetMemoryReport() const { return {}; }
 };
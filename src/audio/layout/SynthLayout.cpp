@@ -4,6 +4,7 @@
 #include "layout/SynthLayout.hpp"
 
 #include <cassert>
+#include <initializer_list>
 
 SynthLayout::SynthLayout()
     : m_oscA(std::make_shared<Oscillator>())
@@ -12,13 +13,15 @@ SynthLayout::SynthLayout()
     , m_hpFilter(std::make_shared<HighPassFilter>())
     , m_delay(std::make_shared<FeedbackDelay>())
     , m_reverb(std::make_shared<Reverb>())
+    , m_reverbClip(std::make_shared<Oversampler>(OversamplingInfo::Factor::x4))
     , m_mixer(std::make_shared<Mixer>())
+    , m_chain(*m_oscA, *m_oscB, *m_lpFilter, *m_hpFilter, *m_delay, *m_reverb, *m_reverbClip, *m_mixer)
     , m_lfo1Periodic(std::make_shared<PeriodicLFO>())
     , m_lfo1Env(std::make_shared<Envelope>())
     , m_lfo1Rnd(std::make_shared<RandomLFO>())
     , m_lfo2Periodic(std::make_shared<PeriodicLFO>())
     , m_lfo2Env(std::make_shared<Envelope>())
-    , m_lfo2Rnd(std::make_shared<RandomLFO>())
+    , m_lfo2Rnd(std::make_shared<RandomLFO>(Frequency(1.0f), 7331)) // Not in lockstep with LFO 1
     , m_filterEnv(std::make_shared<Envelope>(0.0f, 0.0f, 0.0f, 0.0f, 0.0f))
 {
     // Now connect all nodes into a graph
@@ -27,176 +30,203 @@ SynthLayout::SynthLayout()
     m_hpFilter->AddChild(m_lpFilter);
     m_delay->AddChild(m_hpFilter);
     m_reverb->AddChild(m_delay);
-    m_mixer->AddChild(m_reverb);
+
+    // Soft clip the reverb output for safety (prevents runaway feedback), oversampled to avoid aliasing
+    m_reverbClip->AddStage(std::make_shared<Saturator>());
+    m_reverbClip->AddChild(m_reverb);
+    m_mixer->AddChild(m_reverbClip);
 }
 
 std::shared_ptr<AudioProcessor> SynthLayout::GetRootNode() {
     return m_mixer;
 }
 
-void SynthLayout::LoadPreset(AudioPreset& preset) {
-    // Map all key inputs to notes and play the ones currently held down
-    static std::vector<std::pair<const std::atomic<bool>*, Note>> keySettingPairs = {
-        { &preset.noteA5, Note(Key::A, 5) },
-        { &preset.noteAs5, Note(Key::As, 5) },
-        { &preset.noteB5, Note(Key::B, 5) },
-        { &preset.noteC5, Note(Key::C, 5) },
-        { &preset.noteCs5, Note(Key::Cs, 5) },
-        { &preset.noteD5, Note(Key::D, 5) },
-        { &preset.noteDs5, Note(Key::Ds, 5) },
-        { &preset.noteE5, Note(Key::E, 5) },
-        { &preset.noteF5, Note(Key::F, 5) },
-        { &preset.noteFs5, Note(Key::Fs, 5) },
-        { &preset.noteG5, Note(Key::G, 5) },
-        { &preset.noteGs5, Note(Key::Gs, 5) }
+void SynthLayout::NoteOn(Note note, float velocity) {
+    if (!m_pressedNotes.emplace(note, velocity).second) {
+        return; // Already held
+    }
+
+    if (m_oscA->isOn) {
+        m_oscA->NoteOn(note, velocity);
+    }
+    if (m_oscB->isOn) {
+        m_oscB->NoteOn(note, velocity);
+    }
+    m_filterEnv->Restart();
+    m_lfo1Env->Restart();
+    m_lfo2Env->Restart();
+}
+
+void SynthLayout::NoteOff(Note note) {
+    if (m_pressedNotes.erase(note) == 0) {
+        return; // Wasn't held
+    }
+
+    m_oscA->NoteOff(note);
+    m_oscB->NoteOff(note);
+}
+
+void SynthLayout::ReleaseAllNotes() {
+    for (const auto& [note, velocity] : m_pressedNotes) {
+        m_oscA->NoteOff(note);
+        m_oscB->NoteOff(note);
+    }
+    m_pressedNotes.clear();
+}
+
+const std::map<Note, float>& SynthLayout::GetPressedNotes() const noexcept {
+    return m_pressedNotes;
+}
+
+void SynthLayout::Prepare(const ProcessSpec& spec) {
+    AudioLayout::Prepare(spec);
+
+    // The modulation sources aren't part of the graph
+    for (LFO* lfo : std::initializer_list<LFO*> { m_lfo1Periodic.get(), m_lfo1Env.get(), m_lfo1Rnd.get(),
+                                                  m_lfo2Periodic.get(), m_lfo2Env.get(), m_lfo2Rnd.get(),
+                                                  m_filterEnv.get() }) {
+        lfo->SetSampleRate(spec.sampleRate);
+    }
+}
+
+void SynthLayout::LoadPreset(const AudioPreset& preset) {
+    using ParameterInfo::ID;
+    using ParameterInfo::Target;
+
+    // Only reconfigure the parts of the synth whose parameters changed since the last call
+    AudioPreset::TargetSet changed = m_hasLoadedPreset
+        ? preset.GetChangedTargets(m_loadedPreset)
+        : AudioPreset::TargetSet().set();
+    if (changed.none()) {
+        return;
+    }
+    m_loadedPreset = preset;
+    m_hasLoadedPreset = true;
+
+    auto hasChanged = [&](Target target) {
+        return changed.test(static_cast<size_t>(target));
     };
 
-    for (auto& [keySettingPtr, note] : keySettingPairs) {
-        if (keySettingPtr->load()) {
-            if (m_pressedNotes.find(note) == m_pressedNotes.end()) {
-                m_pressedNotes.insert(note);
-
-                // New note pressed
-                if (m_oscA->isOn) {
-                    m_oscA->NoteOn(note);
-                }
-                if (m_oscB->isOn) {
-                    m_oscB->NoteOn(note);
-                }
-                m_filterEnv->Restart();
-                m_lfo1Env->Restart();
-                m_lfo2Env->Restart();
-            }
-        }else {
-            if (m_pressedNotes.find(note) != m_pressedNotes.end()) {
-                m_pressedNotes.erase(note);
-
-                // Note released
-                m_oscA->NoteOff(note);
-                m_oscB->NoteOff(note);
-            }
-        }
+    if (hasChanged(Target::Master)) {
+        m_mixer->gain.SetLinear(preset[ID::MasterVolume]);
     }
 
-    m_oscA->isOn = preset.synthOscAOn.load();
-    m_oscA->gain.SetLinear(preset.synthOscAVolume.load());
-    m_oscA->pan.Set(preset.synthOscAPan.load());
-    m_oscA->SetWaveformType(preset.synthOscAWaveform.load());
-    m_oscA->SetEnvelope(Envelope(
-        preset.synthOscAttack.load(),
-        preset.synthOscHold.load(),
-        preset.synthOscDec.load(),
-        preset.synthOscSus.load(),
-        preset.synthOscRel.load()
-    ));
-    m_oscA->SetOctave(preset.synthOscAOctave.load());
-
-    m_oscB->isOn = preset.synthOscBOn.load();
-    m_oscB->gain.SetLinear(preset.synthOscBVolume.load());
-    m_oscB->pan.Set(preset.synthOscBPan.load());
-    m_oscB->SetWaveformType(preset.synthOscBWaveform.load());
-    m_oscB->SetEnvelope(Envelope(
-        preset.synthOscAttack.load(),
-        preset.synthOscHold.load(),
-        preset.synthOscDec.load(),
-        preset.synthOscSus.load(),
-        preset.synthOscRel.load()
-    ));
-    m_oscB->SetOctave(preset.synthOscBOctave.load());
-
-    m_lpFilter->isOn = preset.synthLpFilterOn.load();
-    m_lpFilter->mix = preset.synthLpFilterMix.load();
-    m_lpFilter->SetCutoffAndPeaking(Frequency(preset.synthLpFilterCutoff.load()), preset.synthLpFilterQ.load());
-
-    m_hpFilter->isOn = preset.synthHpFilterOn.load();
-    m_hpFilter->mix = preset.synthHpFilterMix.load();
-    m_hpFilter->SetCutoffAndPeaking(Frequency(preset.synthHpFilterCutoff.load()), preset.synthHpFilterQ.load());
-
-    m_delay->isOn = preset.synthDelayOn.load();
-    m_delay->mix = preset.synthDelayMix.load();
-    m_delay->SetDelayType(preset.synthDelayType.load());
-    m_delay->SetDelayTime(preset.synthDelayTime.load());
-    m_delay->SetFeedback(preset.synthDelayFeedback.load());
-
-    m_reverb->isOn = preset.synthReverbOn.load();
-    m_reverb->SetParams(preset.synthReverbFeedback.load(), preset.synthReverbDamp.load(), preset.synthReverbWet.load());
-
-    m_mixer->gain.SetLinear(preset.synthMasterVolume.load());
-
-    // Update LFOs
-    m_modMatrix.ClearRoutes();
-
-    m_filterEnv->attack = preset.synthOscLpCutoffAttack.load();
-    m_filterEnv->decay = preset.synthOscLpCutoffDec.load();
-    m_modMatrix.AddRoute(ModulationRoute(m_filterEnv, m_lpFilter, ModulationType::Cutoff, preset.synthOscLpCutoffAmount.load()));
-
-    // Lfo1
-    Frequency lfo1Freq = Frequency(preset.synthLFO1Frequency.load());
-
-    m_lfo1Periodic->SetWaveformType(preset.synthLFO1Waveform.load());
-    m_lfo1Periodic->SetFrequency(lfo1Freq);
-    
-    m_lfo1Env->attack = preset.synthLFO1EnvAttack.load();
-    m_lfo1Env->hold = preset.synthLFO1EnvHold.load();
-    m_lfo1Env->decay = preset.synthLFO1EnvDec.load();
-    m_lfo1Env->sustain = preset.synthLFO1EnvSus.load();
+    if (hasChanged(Target::OscA)) {
+        m_oscA->isOn = preset.GetBool(ID::OscAOn);
+        m_oscA->gain.SetLinear(preset[ID::OscAVolume]);
+        m_oscA->pan.Set(preset[ID::OscAPan]);
+        m_oscA->SetWaveformType(preset.GetChoice<WaveformInfo::Type>(ID::OscAWaveform));
+        m_oscA->SetOctave(preset.GetInt(ID::OscAOctave));
+        m_oscA->SetUnison(preset.GetInt(ID::OscAUnisonVoices), preset[ID::OscAUnisonDetune], preset[ID::OscAUnisonSpread]);
+    }
+
+    if (hasChanged(Target::OscB)) {
+        m_oscB->isOn = preset.GetBool(ID::OscBOn);
+        m_oscB->gain.SetLinear(preset[ID::OscBVolume]);
+        m_oscB->pan.Set(preset[ID::OscBPan]);
+        m_oscB->SetWaveformType(preset.GetChoice<WaveformInfo::Type>(ID::OscBWaveform));
+        m_oscB->SetOctave(preset.GetInt(ID::OscBOctave));
+        m_oscB->SetUnison(preset.GetInt(ID::OscBUnisonVoices), preset[ID::OscBUnisonDetune], preset[ID::OscBUnisonSpread]);
+    }
 
-    m_lfo1Rnd->SetFrequency(lfo1Freq);
+    if (hasChanged(Target::VolumeEnvelope)) {
+        Envelope envelope(
+            preset[ID::OscAttack],
+            preset[ID::OscHold],
+            preset[ID::OscDecay],
+            preset[ID::OscSustain],
+            preset[ID::OscRelease]
+        );
+        m_oscA->SetEnvelope(envelope);
+        m_oscB->SetEnvelope(envelope);
+    }
 
-    // Lfo2
-    Frequency lfo2Freq = Frequency(preset.synthLFO2Frequency.load());
+    if (hasChanged(Target::LowPassFilter)) {
+        m_lpFilter->isOn = preset.GetBool(ID::LpFilterOn);
+        m_lpFilter->mix = preset[ID::LpFilterMix];
+        m_lpFilter->SetCutoffAndPeaking(Frequency(preset[ID::LpFilterCutoff]), preset[ID::LpFilterQ]);
+    }
 
-    m_lfo2Periodic->SetWaveformType(preset.synthLFO2Waveform.load());
-    m_lfo2Periodic->SetFrequency(lfo2Freq);
-    
-    m_lfo2Env->attack = preset.synthLFO2EnvAttack.load();
-    m_lfo2Env->hold = preset.synthLFO2EnvHold.load();
-    m_lfo2Env->decay = preset.synthLFO2EnvDec.load();
-    m_lfo2Env->sustain = preset.synthLFO2EnvSus.load();
-
-    m_lfo2Rnd->SetFrequency(lfo2Freq);
-
-    // Read modulation matrix from preset
-    LFOConfig lfo1Config = ReadLFO1Config(preset);
-    LFOConfig lfo2Config = ReadLFO2Config(preset);
-    AddModulationRoutesForLfoConfig(lfo1Config);
-    AddModulationRoutesForLfoConfig(lfo2Config);
+    if (hasChanged(Target::HighPassFilter)) {
+        m_hpFilter->isOn = preset.GetBool(ID::HpFilterOn);
+        m_hpFilter->mix = preset[ID::HpFilterMix];
+        m_hpFilter->SetCutoffAndPeaking(Frequency(preset[ID::HpFilterCutoff]), preset[ID::HpFilterQ]);
+    }
+
+    if (hasChanged(Target::Delay)) {
+        m_delay->isOn = preset.GetBool(ID::DelayOn);
+        m_delay->mix = preset[ID::DelayMix];
+        m_delay->SetDelayType(preset.GetChoice<FeedbackDelayInfo::Type>(ID::DelayType));
+        m_delay->SetDelayTime(preset[ID::DelayTime]);
+        m_delay->SetFeedback(preset[ID::DelayFeedback]);
+    }
+
+    if (hasChanged(Target::Reverb)) {
+        m_reverb->isOn = preset.GetBool(ID::ReverbOn);
+        m_reverb->SetParams(preset[ID::ReverbFeedback], preset[ID::ReverbDamp], preset[ID::ReverbWet]);
+        m_reverbClip->isOn = m_reverb->isOn;
+    }
+
+    if (hasChanged(Target::FilterEnvelope)) {
+        m_filterEnv->attack = preset[ID::LpCutoffEnvAttack];
+        m_filterEnv->decay = preset[ID::LpCutoffEnvDecay];
+    }
+
+    if (hasChanged(Target::LFO1)) {
+        LoadLFOSources(ReadLFOConfig(preset, ParameterInfo::LFO1_PARAMETERS, 1), *m_lfo1Periodic, *m_lfo1Env, *m_lfo1Rnd);
+    }
+
+    if (hasChanged(Target::LFO2)) {
+        LoadLFOSources(ReadLFOConfig(preset, ParameterInfo::LFO2_PARAMETERS, 2), *m_lfo2Periodic, *m_lfo2Env, *m_lfo2Rnd);
+    }
+
+    // The routes carry the modulation amounts, so rebuild them when any modulation source changed
+    if (hasChanged(Target::FilterEnvelope) || hasChanged(Target::LFO1) || hasChanged(Target::LFO2)) {
+        m_modMatrix.ClearRoutes();
+        m_modMatrix.AddRoute(ModulationRoute(m_filterEnv, m_lpFilter, ModulationType::Cutoff, preset[ID::LpCutoffEnvAmount]));
+        AddModulationRoutesForLfoConfig(ReadLFOConfig(preset, ParameterInfo::LFO1_PARAMETERS, 1));
+        AddModulationRoutesForLfoConfig(ReadLFOConfig(preset, ParameterInfo::LFO2_PARAMETERS, 2));
+    }
 }
 
 void SynthLayout::ApplyAllModulations() {
     m_modMatrix.ApplyModulations();
 }
 
-LFOConfig SynthLayout::ReadLFO1Config(AudioPreset& preset) const {
-    LFOConfig lfo1Config;
-    lfo1Config.on = preset.synthLFO1On.load();
-    lfo1Config.mode = preset.synthLFO1Mode.load();
-    lfo1Config.destination = preset.synthLFO1Destination.load();
-    lfo1Config.amount = preset.synthLFO1Amount.load();
-    lfo1Config.envAttack = preset.synthLFO1EnvAttack.load();
-    lfo1Config.envHold = preset.synthLFO1EnvHold.load();
-    lfo1Config.envDec = preset.synthLFO1EnvDec.load();
-    lfo1Config.envSus = preset.synthLFO1EnvSus.load();
-    lfo1Config.waveform = preset.synthLFO1Waveform.load();
-    lfo1Config.frequency = preset.synthLFO1Frequency.load();
-    lfo1Config.lfoNum = 1;
-    return lfo1Config;
+void SynthLayout::RenderFrames(AudioFrame *output, size_t numFrames) {
+    m_chain.ProcessBlock(output, numFrames, [this] {
+        m_modMatrix.ApplyModulations();
+    });
 }
 
-LFOConfig SynthLayout::ReadLFO2Config(AudioPreset& preset) const {
-    LFOConfig lfo2Config;
-    lfo2Config.on = preset.synthLFO2On.load();
-    lfo2Config.mode = preset.synthLFO2Mode.load();
-    lfo2Config.destination = preset.synthLFO2Destination.load();
-    lfo2Config.amount = preset.synthLFO2Amount.load();
-    lfo2Config.envAttack = preset.synthLFO2EnvAttack.load();
-    lfo2Config.envHold = preset.synthLFO2EnvHold.load();
-    lfo2Config.envDec = preset.synthLFO2EnvDec.load();
-    lfo2Config.envSus = preset.synthLFO2EnvSus.load();
-    lfo2Config.waveform = preset.synthLFO2Waveform.load();
-    lfo2Config.frequency = preset.synthLFO2Frequency.load();
-    lfo2Config.lfoNum = 2;
-    return lfo2Config;
+LFOConfig SynthLayout::ReadLFOConfig(const AudioPreset& preset, const ParameterInfo::LFOParameterIDs& ids, int lfoNum) const {
+    LFOConfig config;
+    config.on = preset.GetBool(ids.on);
+    config.mode = preset.GetChoice<LFOConfig::Mode>(ids.mode);
+    config.destination = preset.GetChoice<LFOConfig::Destination>(ids.destination);
+    config.amount = preset[ids.amount];
+    config.envAttack = preset[ids.envAttack];
+    config.envHold = preset[ids.envHold];
+    config.envDec = preset[ids.envDecay];
+    config.envSus = preset[ids.envSustain];
+    config.waveform = preset.GetChoice<WaveformInfo::Type>(ids.waveform);
+    config.frequency = preset[ids.frequency];
+    config.lfoNum = lfoNum;
+    return config;
+}
+
+void SynthLayout::LoadLFOSources(const LFOConfig& config, PeriodicLFO& periodic, Envelope& envelope, RandomLFO& random) {
+    Frequency frequency = Frequency(config.frequency);
+
+    periodic.SetWaveformType(config.waveform);
+    periodic.SetFrequency(frequency);
+
+    envelope.attack = config.envAttack;
+    envelope.hold = config.envHold;
+    envelope.decay = config.envDec;
+    envelope.sustain = config.envSus;
+
+    random.SetFrequency(frequency);
 }
 
 std::shared_ptr<LFO> SynthLayout::GetLFOSourceHelper(LFOConfig::Mode mode, int lfoNum) {
@@ -274,4 +304,17 @@ void SynthLayout::AddModulationRoutesForLfoConfig(const LFOConfig& config) {
             assert(false && "Unknown LFO destination");
             break;
     }
-}
\ No newline at end of file
+}
+
+std::vector<NodeMemoryUsage> SynthLayout::GetMemoryReport() const {
+    return {
+        {"Oscillator A", m_oscA->GetMemoryUsage()},
+        {"Oscillator B", m_oscB->GetMemoryUsage()},
+        {"Low-pass filter", m_lpFilter->GetMemoryUsage()},
+        {"High-pass filter", m_hpFilter->GetMemoryUsage()},
+        {"Delay", m_delay->GetMemoryUsage()},
+        {"Reverb", m_reverb->GetMemoryUsage()},
+        {"Reverb soft clip", m_reverbClip->GetMemoryUsage()},
+        {"Mixer", m_mixer->GetMemoryUsage()},
+    };
+}
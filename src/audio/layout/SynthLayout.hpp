@@ -5,12 +5,15 @@
 
 #include "layout/AudioLayout.hpp"
 #include "engine/AudioProcessor.hpp"
+#include "engine/StaticChain.hpp"
 #include "preset/AudioPreset.hpp"
 #include "generator/Oscillator.hpp"
 #include "effects/LowPassFilter.hpp"
 #include "effects/HighPassFilter.hpp"
 #include "effects/FeedbackDelay.hpp"
 #include "effects/Reverb.hpp"
+#include "effects/Oversampler.hpp"
+#include "effects/Saturator.hpp"
 #include "effects/Mixer.hpp"
 #include "modulation/Envelope.hpp"
 #include "modulation/ModulationMatrix.hpp"
@@ -18,18 +21,30 @@
 #include "modulation/PeriodicLFO.hpp"
 #include "modulation/RandomLFO.hpp"
 #include <memory>
-#include <set>
+#include <map>
 
 class SynthLayout final: public AudioLayout {
 public:
     SynthLayout();
     std::shared_ptr<AudioProcessor> GetRootNode() override;
-    void LoadPreset(AudioPreset& preset) override;
+    void LoadPreset(const AudioPreset& preset) override;
     void ApplyAllModulations() override;
+    void NoteOn(Note note, float velocity) override;
+    void NoteOff(Note note) override;
+    void ReleaseAllNotes() override;
+
+    // The notes started and not yet stopped, with the velocity each was started with
+    const std::map<Note, float>& GetPressedNotes() const noexcept;
+    void Prepare(const ProcessSpec& spec) override;
+    std::vector<NodeMemoryUsage> GetMemoryReport() const override;
+
+    // Renders the next frames through the fixed chain of the nodes rather than through the graph,
+    // with the same result. Modulations are cleared and applied per frame, as for the graph.
+    void RenderFrames(AudioFrame *output, size_t numFrames);
 
 private:
-    LFOConfig ReadLFO1Config(AudioPreset& preset) const;
-    LFOConfig ReadLFO2Config(AudioPreset& preset) const;
+    LFOConfig ReadLFOConfig(const AudioPreset& preset, const ParameterInfo::LFOParameterIDs& ids, int lfoNum) const;
+    void LoadLFOSources(const LFOConfig& config, PeriodicLFO& periodic, Envelope& envelope, RandomLFO& random);
     std::shared_ptr<LFO> GetLFOSourceHelper(LFOConfig::Mode, int lfoNum);
     void AddModulationRoutesForLfoConfig(const LFOConfig& config);
 
@@ -40,8 +55,15 @@ private:
     std::shared_ptr<HighPassFilter> m_hpFilter;
     std::shared_ptr<FeedbackDelay> m_delay;
     std::shared_ptr<Reverb> m_reverb;
+    std::shared_ptr<Oversampler> m_reverbClip;
     std::shared_ptr<Mixer> m_mixer;
 
+    // The same nodes as the graph: both oscillators summed, then every effect in turn.
+    // Must be kept in step with how the constructor wires up the graph.
+    using Chain = StaticChain<2, Oscillator, Oscillator, LowPassFilter, HighPassFilter,
+                              FeedbackDelay, Reverb, Oversampler, Mixer>;
+    Chain m_chain;
+
     // LFOs
     std::shared_ptr<PeriodicLFO> m_lfo1Periodic;
     std::shared_ptr<Envelope> m_lfo1Env;
@@ -55,5 +77,9 @@ private:
 
     ModulationMatrix m_modMatrix;
 
-    std::set<Note> m_pressedNotes;
+    std::map<Note, float> m_pressedNotes; // With their velocities
+
+    // What LoadPreset() last configured the nodes with, to tell what changed
+    AudioPreset m_loadedPreset;
+    bool m_hasLoadedPreset = false;
 };
\ No newline at end of file
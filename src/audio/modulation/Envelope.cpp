@@ -2,7 +2,6 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "modulation/Envelope.hpp"
-#include "engine/AudioEngine.hpp"
 
 Envelope::Envelope(float atk, float hld, float dec, float sus, float rel)
     : attack(atk), hold(hld), decay(dec), sustain(sus), release(rel) {
@@ -17,9 +16,14 @@ float Envelope::GetNextSample() {
     return nextSample;
 }
 
+void Envelope::SetSampleRate(float sampleRate) {
+    LFO::SetSampleRate(sampleRate);
+    m_sampleTime = 1.0f / sampleRate;
+}
+
 float Envelope::GetNextSampleHelper() {
     // Progress time
-    m_timeSinceStart += 1.0f / SAMPLE_RATE;
+    m_timeSinceStart += m_sampleTime;
 
     if (m_hasBeenReleased) {
         if (m_timeSinceStart < release) {
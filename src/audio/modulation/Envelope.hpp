@@ -14,6 +14,7 @@ public:
     Envelope(float atk, float hld, float dec, float sus, float rel);
 
     float GetNextSample() override;
+    void SetSampleRate(float sampleRate) override;
 
     // Starts the envelope back from the beginning
     void Restart();
@@ -33,6 +34,7 @@ public:
 private:
     float GetNextSampleHelper();
 
+    float m_sampleTime = 1.0f / m_sampleRate; // Seconds per sample
     float m_timeSinceStart = 0.0;
     bool m_hasBeenReleased = false;
     float m_lastValueBeforeRelease = 0.0f;
@@ -9,6 +9,7 @@
 #include <cassert>
 
 #include "core/Waveform.hpp"
+#include "engine/ProcessSpec.hpp"
 
 // Fwd dec.
 class AudioProcessor;
@@ -20,7 +21,7 @@ struct LFOConfig {
         Random
     };
 
-    static inline const char *ModeNames[] = { "Envelope (restart on every note)", "Periodic (repeat continuously)", "Random" };
+    static inline constexpr const char *ModeNames[] = { "Envelope (restart on every note)", "Periodic (repeat continuously)", "Random" };
 
     enum class Destination {
         OscAVolume,
@@ -38,8 +39,14 @@ struct LFOConfig {
         HPPeaking,
     };
 
+    static inline constexpr const char *DestinationNames[] = {
+        "Osc A Volume", "Osc A Pan", "Osc A Pitch",
+        "Osc B Volume", "Osc B Pan", "Osc B Pitch",
+        "Osc AB Volume", "Osc AB Pan", "Osc AB Pitch",
+        "LP Cutoff", "LP Peaking", "HP Cutoff", "HP Peaking"
+    };
+
     struct DestinationInfo {
-        std::string name;
         std::optional<std::string> format;
         float minValue;
         float maxValue;
@@ -47,19 +54,19 @@ struct LFOConfig {
     };
 
     static inline const std::array<std::pair<Destination, DestinationInfo>, 13> DESTINATION_INFOS {{
-        { Destination::OscAVolume, { "Osc A Volume", std::nullopt, -1.0f, 1.0f, false } },
-        { Destination::OscAPan,    { "Osc A Pan", std::nullopt, -1.0f, 1.0f, false } },
-        { Destination::OscAPitch,  { "Osc A Pitch", "%.1f semitones", -60.0f, 60.0f, false } },
-        { Destination::OscBVolume, { "Osc B Volume", std::nullopt, -1.0f, 1.0f, false } },
-        { Destination::OscBPan,    { "Osc B Pan", std::nullopt, -1.0f, 1.0f, false } },
-        { Destination::OscBPitch,  { "Osc B Pitch", "%.1f semitones", -60.0f, 60.0f, false } },
-        { Destination::OscABVolume,{ "Osc AB Volume", std::nullopt, -1.0f, 1.0f, false } },
-        { Destination::OscABPan,   { "Osc AB Pan", std::nullopt, -1.0f, 1.0f, false } },
-        { Destination::OscABPitch, { "Osc AB Pitch", "%.1f semitones", -60.0f, 60.0f, false } },
-        { Destination::LPCutoff,   { "LP Cutoff", "%.1f semitones", -60.0f, 60.0f, true } },
-        { Destination::LPPeaking,  { "LP Peaking", std::nullopt, -3.0f, 3.0f, false } },
-        { Destination::HPCutoff,   { "HP Cutoff", "%.1f semitones", -60.0f, 60.0f, true } },
-        { Destination::HPPeaking,  { "HP Peaking", std::nullopt, -3.0f, 3.0f, false } },
+        { Destination::OscAVolume, { std::nullopt, -1.0f, 1.0f, false } },
+        { Destination::OscAPan,    { std::nullopt, -1.0f, 1.0f, false } },
+        { Destination::OscAPitch,  { "%.1f semitones", -60.0f, 60.0f, false } },
+        { Destination::OscBVolume, { std::nullopt, -1.0f, 1.0f, false } },
+        { Destination::OscBPan,    { std::nullopt, -1.0f, 1.0f, false } },
+        { Destination::OscBPitch,  { "%.1f semitones", -60.0f, 60.0f, false } },
+        { Destination::OscABVolume,{ std::nullopt, -1.0f, 1.0f, false } },
+        { Destination::OscABPan,   { std::nullopt, -1.0f, 1.0f, false } },
+        { Destination::OscABPitch, { "%.1f semitones", -60.0f, 60.0f, false } },
+        { Destination::LPCutoff,   { "%.1f semitones", -60.0f, 60.0f, true } },
+        { Destination::LPPeaking,  { std::nullopt, -3.0f, 3.0f, false } },
+        { Destination::HPCutoff,   { "%.1f semitones", -60.0f, 60.0f, true } },
+        { Destination::HPPeaking,  { std::nullopt, -3.0f, 3.0f, false } },
     }};
 
     static const DestinationInfo& GetDestinationInfo(Destination dest) {
@@ -76,17 +83,6 @@ struct LFOConfig {
         std::terminate(); // never recover, guaranteed crash
     }
 
-    static std::vector<std::string> GetDestinationNames() {
-        std::vector<std::string> names;
-        names.reserve(DESTINATION_INFOS.size());
-
-        for (const auto& entry : DESTINATION_INFOS) {
-            names.push_back(std::string(entry.second.name));
-        }
-
-        return names;
-    }
-
     bool on { false };
     Mode mode { LFOConfig::Mode::Periodic };
     Destination destination { LFOConfig::Destination::OscAVolume };
@@ -104,4 +100,11 @@ class LFO {
 public:
     virtual ~LFO() = default;
     virtual float GetNextSample() = 0;
+
+    // Not while the LFO is being read on the audio thread
+    virtual void SetSampleRate(float sampleRate) { m_sampleRate = sampleRate; }
+    float GetSampleRate() const { return m_sampleRate; }
+
+protected:
+    float m_sampleRate = ProcessSpec::DEFAULT_SAMPLE_RATE;
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "modulation/PeriodicLFO.hpp"
-#include "engine/AudioEngine.hpp"
 
 PeriodicLFO::PeriodicLFO(WaveformInfo::Type type, Frequency frequency)
     : m_waveform(Waveform::ConstructWaveform(type))
@@ -18,7 +17,7 @@ void PeriodicLFO::SetFrequency(Frequency frequency) {
 }
 
 float PeriodicLFO::GetNextSample() {
-    float dt = 1.0 / SAMPLE_RATE;
+    float dt = 1.0 / m_sampleRate;
     float dOffset = dt * m_frequency.GetAbsolute();
     m_currentPhase += dOffset;
 
@@ -2,16 +2,25 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "modulation/RandomLFO.hpp"
-#include "engine/AudioEngine.hpp"
 
-RandomLFO::RandomLFO(Frequency freq) {
-    m_numSamplesPerPeriod = SAMPLE_RATE / freq.GetAbsolute();
+RandomLFO::RandomLFO(Frequency freq, uint32_t seed)
+    : m_gen(seed)
+    , m_dist(0.0f, 1.0f)
+    , m_frequency(freq)
+{
+    m_numSamplesPerPeriod = m_sampleRate / freq.GetAbsolute();
     m_lastRandValue = GenerateRandValueHelper();
     m_nextRandValue = GenerateRandValueHelper();
 }
 
 void RandomLFO::SetFrequency(Frequency freq) {
-    m_numSamplesPerPeriod = SAMPLE_RATE / freq.GetAbsolute();
+    m_frequency = freq;
+    m_numSamplesPerPeriod = m_sampleRate / freq.GetAbsolute();
+}
+
+void RandomLFO::SetSampleRate(float sampleRate) {
+    LFO::SetSampleRate(sampleRate);
+    SetFrequency(m_frequency);
 }
 
 float RandomLFO::GetNextSample() {
@@ -29,7 +38,7 @@ float RandomLFO::GetNextSample() {
 }
 
 float RandomLFO::GenerateRandValueHelper() {
-    return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    return m_dist(m_gen);
 }
 
 float RandomLFO::CubicInterpolate(float y0, float y1, float t, float m0, float m1) {
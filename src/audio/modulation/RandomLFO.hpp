@@ -3,14 +3,20 @@
 
 #pragma once
 
+#include <cstdint>
+#include <random>
+
 #include "modulation/LFO.hpp"
 #include "core/Frequency.hpp"
 
+// Glides smoothly between random values, one per period. The values come from a seeded
+// generator, so the same notes on the same preset always render the same audio.
 class RandomLFO: public LFO {
 public:
-    RandomLFO(Frequency freq = Frequency(1.0f));
+    RandomLFO(Frequency freq = Frequency(1.0f), uint32_t seed = 1337);
 
     void SetFrequency(Frequency freq);
+    void SetSampleRate(float sampleRate) override;
 
     float GetNextSample() override;
 
@@ -22,6 +28,10 @@ private:
     // Optional tangents m0 and m1; default to 0 for simple smoothness
     float CubicInterpolate(float y0, float y1, float t, float m0 = 0.0, float m1 = 0.0);
 
+    std::mt19937 m_gen;
+    std::uniform_real_distribution<float> m_dist;
+
+    Frequency m_frequency;
     float m_lastRandValue;
     float m_nextRandValue;
     int m_sampleCount = 0;
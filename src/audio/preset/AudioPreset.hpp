@@ -3,91 +3,49 @@
 
 #pragma once
 
-#include <atomic>
-#include "core/Waveform.hpp"
-#include "effects/util/FeedbackDelayInfo.hpp"
-#include "modulation/LFO.hpp"
+#include <array>
+#include <bitset>
 
-struct AudioPreset {
-    // Synth settings
-    std::atomic<float> synthMasterVolume { 0.05f };
-
-    std::atomic<WaveformInfo::Type> synthOscAWaveform { WaveformInfo::Type::Saw };
-    std::atomic<bool> synthOscAOn { true };
-    std::atomic<float> synthOscAVolume { 0.7f };
-    std::atomic<float> synthOscAPan { 0.5f };
-    std::atomic<int> synthOscAOctave { 5 };
-
-    std::atomic<WaveformInfo::Type> synthOscBWaveform { WaveformInfo::Type::Saw };
-    std::atomic<bool> synthOscBOn { false };
-    std::atomic<float> synthOscBVolume { 0.7f };
-    std::atomic<float> synthOscBPan { 0.5f };
-    std::atomic<int> synthOscBOctave { 5 };
-
-    std::atomic<float> synthOscAttack { 0.0f };
-    std::atomic<float> synthOscHold { 0.0f };
-    std::atomic<float> synthOscDec { 0.0f };
-    std::atomic<float> synthOscSus { 1.0f };
-    std::atomic<float> synthOscRel { 0.0f };
-
-    std::atomic<bool> synthLpFilterOn { true };
-    std::atomic<float> synthLpFilterMix { 1.0f };
-    std::atomic<float> synthLpFilterCutoff { 5000.0f };
-    std::atomic<float> synthLpFilterQ { 0.707f };
-
-    std::atomic<float> synthOscLpCutoffAttack { 0.0f };
-    std::atomic<float> synthOscLpCutoffDec { 0.0f };
-    std::atomic<float> synthOscLpCutoffAmount { 12.0f };
-    
-    std::atomic<bool> synthHpFilterOn { false };
-    std::atomic<float> synthHpFilterMix { 1.0f };
-    std::atomic<float> synthHpFilterCutoff { 1000.0f };
-    std::atomic<float> synthHpFilterQ { 0.707f };
+#include "preset/ParameterRegistry.hpp"
 
-    std::atomic<bool> synthDelayOn { false };
-    std::atomic<FeedbackDelayInfo::Type> synthDelayType { FeedbackDelayInfo::Type::Mono };
-    std::atomic<float> synthDelayMix { 1.0f };
-    std::atomic<float> synthDelayTime { 0.2f };
-    std::atomic<float> synthDelayFeedback { 0.5f };
-
-    std::atomic<bool> synthReverbOn { false };
-    std::atomic<float> synthReverbFeedback { 0.8f };
-    std::atomic<float> synthReverbDamp { 0.2f };
-    std::atomic<float> synthReverbWet { 0.5f };
-
-    std::atomic<bool> synthLFO1On { false };
-    std::atomic<LFOConfig::Mode> synthLFO1Mode { LFOConfig::Mode::Periodic };
-    std::atomic<LFOConfig::Destination> synthLFO1Destination { LFOConfig::Destination::OscAVolume };
-    std::atomic<float> synthLFO1Amount { 0.0f };
-    std::atomic<float> synthLFO1EnvAttack { 0.0f };
-    std::atomic<float> synthLFO1EnvHold { 0.0f };
-    std::atomic<float> synthLFO1EnvDec { 0.0f };
-    std::atomic<float> synthLFO1EnvSus { 1.0f };
-    std::atomic<WaveformInfo::Type> synthLFO1Waveform { WaveformInfo::Type::Saw };
-    std::atomic<float> synthLFO1Frequency { 1.0f };
-
-    std::atomic<bool> synthLFO2On { false };
-    std::atomic<LFOConfig::Mode> synthLFO2Mode { LFOConfig::Mode::Periodic };
-    std::atomic<LFOConfig::Destination> synthLFO2Destination { LFOConfig::Destination::OscAVolume };
-    std::atomic<float> synthLFO2Amount { 0.0f };
-    std::atomic<float> synthLFO2EnvAttack { 0.0f };
-    std::atomic<float> synthLFO2EnvHold { 0.0f };
-    std::atomic<float> synthLFO2EnvDec { 0.0f };
-    std::atomic<float> synthLFO2EnvSus { 1.0f };
-    std::atomic<WaveformInfo::Type> synthLFO2Waveform { WaveformInfo::Type::Saw };
-    std::atomic<float> synthLFO2Frequency { 1.0f };
-
-    // Non-settings. Used to communicate key-presses to audio engine
-    std::atomic<bool> noteA5 { false };
-    std::atomic<bool> noteAs5 { false };
-    std::atomic<bool> noteB5 { false };
-    std::atomic<bool> noteC5 { false };
-    std::atomic<bool> noteCs5 { false };
-    std::atomic<bool> noteD5 { false };
-    std::atomic<bool> noteDs5 { false };
-    std::atomic<bool> noteE5 { false };
-    std::atomic<bool> noteF5 { false };
-    std::atomic<bool> noteFs5 { false };
-    std::atomic<bool> noteG5 { false };
-    std::atomic<bool> noteGs5 { false };
-};
\ No newline at end of file
+// All the settings of the synth, as a plain value. The GUI edits its own copy and publishes
+// snapshots of it to the audio thread (see PresetPublisher), so the engine always sees a
+// complete preset, never one that is half old and half new.
+// The values sit in one flat array indexed by ParameterInfo::ID, described by PARAMETER_SPECS,
+// so a preset is copied, compared and interpolated as a single block of floats.
+struct AudioPreset {
+    using Values = std::array<float, ParameterInfo::NUM_PARAMETERS>;
+    using TargetSet = std::bitset<ParameterInfo::NUM_TARGETS>;
+
+    static constexpr Values GetDefaultValues() {
+        Values defaults {};
+        for (const ParameterSpec& spec : PARAMETER_SPECS) {
+            defaults[static_cast<size_t>(spec.id)] = spec.defaultValue;
+        }
+        return defaults;
+    }
+
+    bool operator==(const AudioPreset& other) const = default;
+
+    float& operator[](ParameterInfo::ID id) noexcept { return values[static_cast<size_t>(id)]; }
+    float operator[](ParameterInfo::ID id) const noexcept { return values[static_cast<size_t>(id)]; }
+
+    bool GetBool(ParameterInfo::ID id) const noexcept { return (*this)[id] >= 0.5f; }
+    int GetInt(ParameterInfo::ID id) const noexcept { return static_cast<int>((*this)[id] + 0.5f); }
+
+    template <typename Enum>
+    Enum GetChoice(ParameterInfo::ID id) const noexcept { return static_cast<Enum>(GetInt(id)); }
+
+    // The targets (see ParameterInfo::Target) with at least one parameter that differs from `other`
+    TargetSet GetChangedTargets(const AudioPreset& other) const noexcept {
+        TargetSet changed;
+        for (const ParameterSpec& spec : PARAMETER_SPECS) {
+            if ((*this)[spec.id] != other[spec.id]) {
+                changed.set(static_cast<size_t>(spec.target));
+            }
+        }
+        return changed;
+    }
+
+    Values values = GetDefaultValues();
+};
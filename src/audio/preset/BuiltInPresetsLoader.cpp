@@ -2,7 +2,6 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "BuiltInPresetsLoader.hpp"
-#include "AudioPresetSerialization.hpp"
 #include <ranges>
 #include <iostream>
 
@@ -56,16 +55,14 @@ int BuiltInPresetsLoader::GetIndexOfDefaultPreset() {
 }
 
 bool BuiltInPresetsLoader::LoadBuiltInPreset(AudioPreset& preset, const std::string& name) const {
-    namespace fs = std::filesystem;
-
-    fs::path presetPath = m_builtInPresetsFolder / (name + ".json");
-
-    if (!fs::exists(presetPath)) {
-        std::cerr << "Preset not found: " << presetPath << std::endl;
+    std::optional<size_t> index = m_bank.Find(name);
+    if (!index.has_value()) {
+        std::cerr << "Preset not found: " << name << std::endl;
         return false;
     }
 
-    return AudioPresetIO::LoadFromFile(preset, presetPath.string());
+    m_bank.Load(preset, *index);
+    return true;
 }
 
 bool BuiltInPresetsLoader::LoadDefaultPreset(AudioPreset& preset) const {
@@ -75,20 +72,12 @@ bool BuiltInPresetsLoader::LoadDefaultPreset(AudioPreset& preset) const {
 BuiltInPresetsLoader::BuiltInPresetsLoader()
     : m_builtInPresetsFolder(BuiltInPresetsLoader::GetPresetsFolder()) {
 
-    namespace fs = std::filesystem;
+    // Parses the JSON files only if they changed since the bank was last compiled
+    m_bank.Open(m_builtInPresetsFolder, GetExecutableDir() / BANK_FILE_NAME);
 
-    try {
-        if (fs::exists(m_builtInPresetsFolder) && fs::is_directory(m_builtInPresetsFolder)) {
-            for (const auto& entry : fs::directory_iterator(m_builtInPresetsFolder)) {
-                if (entry.is_regular_file() && entry.path().extension() == ".json") {
-                    m_presetNames.push_back(entry.path().stem().string()); // store name without extension
-                }
-            }
-        }else {
-            std::cerr << "Preset folder not found: " << m_builtInPresetsFolder << std::endl;
-        }
-    }catch (const std::exception& e) {
-        std::cerr << "Error loading presets: " << e.what() << std::endl;
+    m_presetNames.reserve(m_bank.GetNumPresets());
+    for (size_t i = 0; i < m_bank.GetNumPresets(); i++) {
+        m_presetNames.emplace_back(m_bank.GetName(i));
     }
 }
 
@@ -7,6 +7,7 @@
 #include <string>
 #include <filesystem>
 #include "preset/AudioPreset.hpp"
+#include "preset/PresetBank.hpp"
 
 
 class BuiltInPresetsLoader {
@@ -16,21 +17,22 @@ public:
         return instance;
     }
 
-    // Return list of preset names
+    // Return list of preset names, sorted
     std::vector<std::string>& GetPresetNames();
     
     // Returns the index of the name in the list of preset names that corresponds to the default preset.
     // Returns -1 if it wasn't found.
     int GetIndexOfDefaultPreset();
 
-    // Load a preset by name (adds ".json" automatically)
+    // Load a preset by name (the JSON file name without ".json"). Served from the compiled
+    // preset bank, so it doesn't touch the disk.
     bool LoadBuiltInPreset(AudioPreset& preset, const std::string& name) const;
 
     // Loads the "chirp" preset
     bool LoadDefaultPreset(AudioPreset& preset) const;
 
 private:
-    // Reads preset names once and saves them internally in the singleton object
+    // Opens (or first compiles) the preset bank once, and saves the names internally in the singleton object
     BuiltInPresetsLoader();
 
     // Return preset folder path (cross-platform safe)
@@ -39,6 +41,10 @@ private:
         std::filesystem::path("..") / "presets";
     static inline const std::string DEFAULT_PRESET_NAME = "chirp";
 
+    // Compiled next to the executable rather than in the presets folder, which is the source
+    static inline const std::filesystem::path BANK_FILE_NAME = "presets.bank";
+
     std::vector<std::string> m_presetNames;
     std::filesystem::path m_builtInPresetsFolder;
+    PresetBank m_bank;
 };
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file. The OS pages the contents in on first touch,
+// so opening is cheap no matter the size, and reading is plain memory access.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the file, replacing any earlier mapping. Returns false if it can't be opened or is empty.
+    bool Open(const std::filesystem::path& path);
+    void Close() noexcept;
+
+    const std::byte *GetData() const noexcept { return m_data; }
+    size_t GetSize() const noexcept { return m_size; }
+
+private:
+    const std::byte *m_data = nullptr;
+    size_t m_size = 0;
+
+#if defined(_WIN32)
+    void *m_fileHandle = nullptr;
+    void *m_mappingHandle = nullptr;
+#endif
+};
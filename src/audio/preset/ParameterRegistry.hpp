@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+#include "core/Waveform.hpp"
+#include "effects/util/FeedbackDelayInfo.hpp"
+#include "effects/util/FeedbackDelayLine.hpp"
+#include "generator/Unison.hpp"
+#include "modulation/LFO.hpp"
+
+namespace ParameterInfo {
+    // Every setting of the synth. The order is the order of the values in a preset,
+    // of the widgets in the GUI, and of the entries in PARAMETER_SPECS below.
+    enum class ID {
+        MasterVolume,
+
+        OscAOn,
+        OscAWaveform,
+        OscAVolume,
+        OscAPan,
+        OscAOctave,
+        OscAUnisonVoices,
+        OscAUnisonDetune,
+        OscAUnisonSpread,
+
+        OscBOn,
+        OscBWaveform,
+        OscBVolume,
+        OscBPan,
+        OscBOctave,
+        OscBUnisonVoices,
+        OscBUnisonDetune,
+        OscBUnisonSpread,
+
+        OscAttack,
+        OscHold,
+        OscDecay,
+        OscSustain,
+        OscRelease,
+
+        LpFilterOn,
+        LpFilterMix,
+        LpFilterCutoff,
+        LpFilterQ,
+
+        LpCutoffEnvAttack,
+        LpCutoffEnvDecay,
+        LpCutoffEnvAmount,
+
+        HpFilterOn,
+        HpFilterMix,
+        HpFilterCutoff,
+        HpFilterQ,
+
+        DelayOn,
+        DelayType,
+        DelayMix,
+        DelayTime,
+        DelayFeedback,
+
+        ReverbOn,
+        ReverbFeedback,
+        ReverbDamp,
+        ReverbWet,
+
+        LFO1On,
+        LFO1Mode,
+        LFO1Destination,
+        LFO1Amount,
+        LFO1EnvAttack,
+        LFO1EnvHold,
+        LFO1EnvDecay,
+        LFO1EnvSustain,
+        LFO1Waveform,
+        LFO1Frequency,
+
+        LFO2On,
+        LFO2Mode,
+        LFO2Destination,
+        LFO2Amount,
+        LFO2EnvAttack,
+        LFO2EnvHold,
+        LFO2EnvDecay,
+        LFO2EnvSustain,
+        LFO2Waveform,
+        LFO2Frequency,
+
+        Count
+    };
+
+    // How a value is stored in preset files and edited in the GUI. All values are floats in memory.
+    enum class Kind {
+        Float,
+        Int,
+        Bool,
+        Choice // Index into the spec's choiceNames
+    };
+
+    // The part of the synth a parameter belongs to. Changing a parameter only reconfigures its target.
+    enum class Target {
+        Master,
+        OscA,
+        OscB,
+        VolumeEnvelope,
+        LowPassFilter,
+        FilterEnvelope,
+        HighPassFilter,
+        Delay,
+        Reverb,
+        LFO1,
+        LFO2,
+
+        Count
+    };
+
+    inline constexpr const char* TargetNames[] = {
+        "Global settings", "Oscillator A", "Oscillator B", "Volume envelope", "Low-pass filter",
+        "Low-pass filter cutoff envelope", "High-pass filter", "Feedback delay", "Reverb settings",
+        "LFO 1", "LFO 2"
+    };
+
+    constexpr size_t NUM_PARAMETERS = static_cast<size_t>(ID::Count);
+    constexpr size_t NUM_TARGETS = static_cast<size_t>(Target::Count);
+}
+
+struct ParameterSpec {
+    ParameterInfo::ID id;
+    const char *key;   // Name in preset files
+    const char *label; // Name in the GUI
+    ParameterInfo::Kind kind;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+    float smoothingTime; // Seconds the audio thread takes to glide to a new value, 0 to jump
+    ParameterInfo::Target target;
+    const char *format = nullptr; // GUI number format, nullptr for the default
+    bool isLogarithmic = false;   // GUI slider scale
+    bool isSaved = true;          // Whether preset files store it
+    const char *const *choiceNames = nullptr;
+};
+
+namespace ParameterDetail {
+    using enum ParameterInfo::ID;
+    using enum ParameterInfo::Kind;
+    // Not `using enum`, whose Target::Count would clash with ID::Count
+    using ParameterInfo::Target::Master, ParameterInfo::Target::OscA, ParameterInfo::Target::OscB,
+          ParameterInfo::Target::VolumeEnvelope, ParameterInfo::Target::LowPassFilter,
+          ParameterInfo::Target::FilterEnvelope, ParameterInfo::Target::HighPassFilter,
+          ParameterInfo::Target::Delay, ParameterInfo::Target::Reverb,
+          ParameterInfo::Target::LFO1, ParameterInfo::Target::LFO2;
+
+    constexpr float NUM_WAVEFORMS = static_cast<float>(std::size(WaveformInfo::Names));
+    constexpr float NUM_DELAY_TYPES = static_cast<float>(std::size(FeedbackDelayInfo::Names));
+    constexpr float NUM_LFO_MODES = static_cast<float>(std::size(LFOConfig::ModeNames));
+    constexpr float NUM_LFO_DESTINATIONS = static_cast<float>(std::size(LFOConfig::DestinationNames));
+
+    // Short glides for levels, so dragging a slider doesn't step audibly between GUI frames
+    constexpr float LEVEL_SMOOTHING = 0.02f;
+    constexpr float FILTER_SMOOTHING = 0.03f;
+    constexpr float FEEDBACK_SMOOTHING = 0.05f;
+
+    constexpr ParameterSpec WaveformChoice(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Waveform", Choice, 0.0f, NUM_WAVEFORMS - 1.0f,
+                 static_cast<float>(WaveformInfo::Type::Saw), 0.0f, target,
+                 nullptr, false, true, WaveformInfo::Names };
+    }
+
+    constexpr ParameterSpec Seconds(ParameterInfo::ID id, const char *key, const char *label,
+                                    float maxValue, ParameterInfo::Target target) {
+        return { id, key, label, Float, 0.0f, maxValue, 0.0f, 0.0f, target };
+    }
+
+    constexpr ParameterSpec Level(ParameterInfo::ID id, const char *key, const char *label,
+                                  float defaultValue, ParameterInfo::Target target) {
+        return { id, key, label, Float, 0.0f, 1.0f, defaultValue, LEVEL_SMOOTHING, target };
+    }
+
+    constexpr ParameterSpec Switch(ParameterInfo::ID id, const char *key, bool defaultValue,
+                                   ParameterInfo::Target target) {
+        return { id, key, "On", Bool, 0.0f, 1.0f, defaultValue ? 1.0f : 0.0f, 0.0f, target };
+    }
+
+    constexpr ParameterSpec UnisonVoices(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Unison voices", Int, 1.0f, static_cast<float>(Unison::MAX_VOICES), 1.0f, 0.0f, target };
+    }
+
+    constexpr ParameterSpec UnisonDetune(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Unison detune (cents)", Float, 0.0f, 100.0f, 20.0f, LEVEL_SMOOTHING, target };
+    }
+
+    constexpr ParameterSpec LFOMode(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Mode", Choice, 0.0f, NUM_LFO_MODES - 1.0f,
+                 static_cast<float>(LFOConfig::Mode::Periodic), 0.0f, target,
+                 nullptr, false, true, LFOConfig::ModeNames };
+    }
+
+    constexpr ParameterSpec LFODestination(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Destination", Choice, 0.0f, NUM_LFO_DESTINATIONS - 1.0f,
+                 static_cast<float>(LFOConfig::Destination::OscAVolume), 0.0f, target,
+                 nullptr, false, true, LFOConfig::DestinationNames };
+    }
+
+    // The range covers every destination; the GUI narrows it to the selected one
+    constexpr ParameterSpec LFOAmount(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Amount", Float, -60.0f, 60.0f, 0.0f, LEVEL_SMOOTHING, target };
+    }
+
+    constexpr ParameterSpec LFOFrequency(ParameterInfo::ID id, const char *key, ParameterInfo::Target target) {
+        return { id, key, "Frequency (Hz)", Float, 0.1f, 100.0f, 1.0f, 0.0f, target };
+    }
+
+    constexpr std::array<ParameterSpec, ParameterInfo::NUM_PARAMETERS> MakeParameterSpecs() {
+        return {{
+            { MasterVolume, "synthMasterVolume", "Master volume", Float, 0.0f, 1.0f, 0.05f, LEVEL_SMOOTHING, Master,
+              nullptr, false, false }, // The listening level, so loading a preset leaves it alone
+
+            Switch(OscAOn, "synthOscAOn", true, OscA),
+            WaveformChoice(OscAWaveform, "synthOscAWaveform", OscA),
+            Level(OscAVolume, "synthOscAVolume", "Volume", 0.7f, OscA),
+            Level(OscAPan, "synthOscAPan", "Pan", 0.5f, OscA),
+            { OscAOctave, "synthOscAOctave", "Octave", Int, 1.0f, 7.0f, 5.0f, 0.0f, OscA },
+            UnisonVoices(OscAUnisonVoices, "synthOscAUnisonVoices", OscA),
+            UnisonDetune(OscAUnisonDetune, "synthOscAUnisonDetune", OscA),
+            Level(OscAUnisonSpread, "synthOscAUnisonSpread", "Unison spread", 0.5f, OscA),
+
+            Switch(OscBOn, "synthOscBOn", false, OscB),
+            WaveformChoice(OscBWaveform, "synthOscBWaveform", OscB),
+            Level(OscBVolume, "synthOscBVolume", "Volume", 0.7f, OscB),
+            Level(OscBPan, "synthOscBPan", "Pan", 0.5f, OscB),
+            { OscBOctave, "synthOscBOctave", "Octave", Int, 1.0f, 7.0f, 5.0f, 0.0f, OscB },
+            UnisonVoices(OscBUnisonVoices, "synthOscBUnisonVoices", OscB),
+            UnisonDetune(OscBUnisonDetune, "synthOscBUnisonDetune", OscB),
+            Level(OscBUnisonSpread, "synthOscBUnisonSpread", "Unison spread", 0.5f, OscB),
+
+            Seconds(OscAttack, "synthOscAttack", "Attack (s)", 2.0f, VolumeEnvelope),
+            Seconds(OscHold, "synthOscHold", "Hold (s)", 2.0f, VolumeEnvelope),
+            Seconds(OscDecay, "synthOscDec", "Decay (s)", 2.0f, VolumeEnvelope),
+            { OscSustain, "synthOscSus", "Sustain (level)", Float, 0.0f, 1.0f, 1.0f, 0.0f, VolumeEnvelope },
+            Seconds(OscRelease, "synthOscRel", "Release (s)", 4.0f, VolumeEnvelope),
+
+            Switch(LpFilterOn, "synthLpFilterOn", true, LowPassFilter),
+            Level(LpFilterMix, "synthLpFilterMix", "Mix", 1.0f, LowPassFilter),
+            { LpFilterCutoff, "synthLpFilterCutoff", "Cutoff frequency (Hz)", Float, 20.0f, 20000.0f, 5000.0f,
+              FILTER_SMOOTHING, LowPassFilter, "%.1f Hz", true },
+            { LpFilterQ, "synthLpFilterQ", "Peaking/Q", Float, 0.1f, 3.0f, 0.707f, FILTER_SMOOTHING, LowPassFilter },
+
+            Seconds(LpCutoffEnvAttack, "synthOscLpCutoffAttack", "Attack (s)", 2.0f, FilterEnvelope),
+            Seconds(LpCutoffEnvDecay, "synthOscLpCutoffDec", "Decay (s)", 2.0f, FilterEnvelope),
+            { LpCutoffEnvAmount, "synthOscLpCutoffAmount", "Amount (semitones)", Float, -60.0f, 60.0f, 12.0f,
+              LEVEL_SMOOTHING, FilterEnvelope },
+
+            Switch(HpFilterOn, "synthHpFilterOn", false, HighPassFilter),
+            Level(HpFilterMix, "synthHpFilterMix", "Mix", 1.0f, HighPassFilter),
+            { HpFilterCutoff, "synthHpFilterCutoff", "Cutoff frequency (Hz)", Float, 20.0f, 20000.0f, 1000.0f,
+              FILTER_SMOOTHING, HighPassFilter, "%.1f Hz", true },
+            { HpFilterQ, "synthHpFilterQ", "Peaking/Q", Float, 0.1f, 3.0f, 0.707f, FILTER_SMOOTHING, HighPassFilter },
+
+            Switch(DelayOn, "synthDelayOn", false, Delay),
+            { DelayType, "synthDelayType", "Delay mode", Choice, 0.0f, NUM_DELAY_TYPES - 1.0f,
+              static_cast<float>(FeedbackDelayInfo::Type::Mono), 0.0f, Delay,
+              nullptr, false, true, FeedbackDelayInfo::Names },
+            Level(DelayMix, "synthDelayMix", "Mix", 1.0f, Delay),
+            // The delay line glides between delay times by itself
+            { DelayTime, "synthDelayTime", "Delay time (s)", Float,
+              FeedbackDelayLine::MIN_DELAY_SEC, FeedbackDelayLine::MAX_DELAY_SEC, 0.2f, 0.0f, Delay },
+            { DelayFeedback, "synthDelayFeedback", "Feedback level", Float,
+              FeedbackDelayLine::MIN_FEEDBACK, FeedbackDelayLine::MAX_FEEDBACK, 0.5f, FEEDBACK_SMOOTHING, Delay },
+
+            Switch(ReverbOn, "synthReverbOn", false, Reverb),
+            { ReverbFeedback, "synthReverbFeedback", "Feedback level", Float, 0.0f, 0.8f, 0.8f, FEEDBACK_SMOOTHING, Reverb },
+            { ReverbDamp, "synthReverbDamp", "Damp level", Float, 0.0f, 1.0f, 0.2f, FEEDBACK_SMOOTHING, Reverb },
+            Level(ReverbWet, "synthReverbWet", "Wet level / Mix", 0.5f, Reverb),
+
+            Switch(LFO1On, "synthLFO1On", false, LFO1),
+            LFOMode(LFO1Mode, "synthLFO1Mode", LFO1),
+            LFODestination(LFO1Destination, "synthLFO1Destination", LFO1),
+            LFOAmount(LFO1Amount, "synthLFO1Amount", LFO1),
+            Seconds(LFO1EnvAttack, "synthLFO1EnvAttack", "Attack (s)", 2.0f, LFO1),
+            Seconds(LFO1EnvHold, "synthLFO1EnvHold", "Hold (s)", 2.0f, LFO1),
+            Seconds(LFO1EnvDecay, "synthLFO1EnvDec", "Decay (s)", 2.0f, LFO1),
+            { LFO1EnvSustain, "synthLFO1EnvSus", "Sustain (level)", Float, 0.0f, 1.0f, 1.0f, 0.0f, LFO1 },
+            WaveformChoice(LFO1Waveform, "synthLFO1Waveform", LFO1),
+            LFOFrequency(LFO1Frequency, "synthLFO1Frequency", LFO1),
+
+            Switch(LFO2On, "synthLFO2On", false, LFO2),
+            LFOMode(LFO2Mode, "synthLFO2Mode", LFO2),
+            LFODestination(LFO2Destination, "synthLFO2Destination", LFO2),
+            LFOAmount(LFO2Amount, "synthLFO2Amount", LFO2),
+            Seconds(LFO2EnvAttack, "synthLFO2EnvAttack", "Attack (s)", 2.0f, LFO2),
+            Seconds(LFO2EnvHold, "synthLFO2EnvHold", "Hold (s)", 2.0f, LFO2),
+            Seconds(LFO2EnvDecay, "synthLFO2EnvDec", "Decay (s)", 2.0f, LFO2),
+            { LFO2EnvSustain, "synthLFO2EnvSus", "Sustain (level)", Float, 0.0f, 1.0f, 1.0f, 0.0f, LFO2 },
+            WaveformChoice(LFO2Waveform, "synthLFO2Waveform", LFO2),
+            LFOFrequency(LFO2Frequency, "synthLFO2Frequency", LFO2),
+        }};
+    }
+}
+
+// The single description of every parameter. Preset files, GUI widgets and the audio thread's
+// binding to the synth nodes are all driven by this table, so adding a parameter means adding
+// an ID and an entry here, plus the line in SynthLayout that hands it to its node.
+inline constexpr std::array<ParameterSpec, ParameterInfo::NUM_PARAMETERS> PARAMETER_SPECS =
+    ParameterDetail::MakeParameterSpecs();
+
+namespace ParameterInfo {
+    constexpr const ParameterSpec& GetSpec(ID id) {
+        return PARAMETER_SPECS[static_cast<size_t>(id)];
+    }
+
+    // The same set of parameters for each LFO, so one piece of code can handle either
+    struct LFOParameterIDs {
+        ID on;
+        ID mode;
+        ID destination;
+        ID amount;
+        ID envAttack;
+        ID envHold;
+        ID envDecay;
+        ID envSustain;
+        ID waveform;
+        ID frequency;
+    };
+
+    inline constexpr LFOParameterIDs LFO1_PARAMETERS {
+        ID::LFO1On, ID::LFO1Mode, ID::LFO1Destination, ID::LFO1Amount, ID::LFO1EnvAttack,
+        ID::LFO1EnvHold, ID::LFO1EnvDecay, ID::LFO1EnvSustain, ID::LFO1Waveform, ID::LFO1Frequency
+    };
+
+    inline constexpr LFOParameterIDs LFO2_PARAMETERS {
+        ID::LFO2On, ID::LFO2Mode, ID::LFO2Destination, ID::LFO2Amount, ID::LFO2EnvAttack,
+        ID::LFO2EnvHold, ID::LFO2EnvDecay, ID::LFO2EnvSustain, ID::LFO2Waveform, ID::LFO2Frequency
+    };
+}
+
+// Lookups index the table by ID, so an entry out of place would silently describe the wrong parameter
+static_assert([] {
+    for (size_t i = 0; i < PARAMETER_SPECS.size(); i++) {
+        const ParameterSpec& spec = PARAMETER_SPECS[i];
+        if (static_cast<size_t>(spec.id) != i || spec.minValue > spec.defaultValue || spec.defaultValue > spec.maxValue) {
+            return false;
+        }
+    }
+    return true;
+}(), "PARAMETER_SPECS must list every parameter in ID order, with its default inside its range");
+
+static_assert(std::size(ParameterInfo::TargetNames) == ParameterInfo::NUM_TARGETS);
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "preset/PresetBank.hpp"
+#include "preset/AudioPresetSerialization.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // 64-bit FNV-1a
+    constexpr uint64_t s_hashSeed = 14695981039346656037ull;
+
+    uint64_t HashBytes(uint64_t hash, const void *data, size_t size) {
+        const unsigned char *bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    uint64_t HashString(uint64_t hash, std::string_view str) {
+        // Include the terminator, so that "ab" + "c" differs from "a" + "bc"
+        return HashBytes(hash, str.data(), str.size() + 1);
+    }
+}
+
+bool PresetBank::Open(const fs::path& presetsFolder, const fs::path& bankPath) {
+    static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Entry>);
+
+    m_file.Close();
+    m_image.clear();
+    m_data = nullptr;
+    m_numPresets = 0;
+    m_indexByName.clear();
+
+    std::vector<fs::path> jsonFiles;
+    try {
+        if (!fs::is_directory(presetsFolder)) {
+            std::cerr << "Preset folder not found: " << presetsFolder << std::endl;
+            return false;
+        }
+        for (const auto& entry : fs::directory_iterator(presetsFolder)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                jsonFiles.push_back(entry.path());
+            }
+        }
+    }catch (const std::exception& e) {
+        std::cerr << "Error loading presets: " << e.what() << std::endl;
+        return false;
+    }
+    std::sort(jsonFiles.begin(), jsonFiles.end());
+
+    uint64_t sourceHash = HashSources(jsonFiles);
+
+    // The common case: the bank from an earlier run is still up to date
+    if (m_file.Open(bankPath) && IsValid(m_file.GetData(), m_file.GetSize(), sourceHash)) {
+        Adopt(m_file.GetData());
+        return m_numPresets > 0;
+    }
+    m_file.Close();
+
+    m_image = Compile(jsonFiles, sourceHash);
+    if (Save(m_image, bankPath) && m_file.Open(bankPath) && IsValid(m_file.GetData(), m_file.GetSize(), sourceHash)) {
+        m_image.clear();
+        m_image.shrink_to_fit();
+        Adopt(m_file.GetData());
+    }else {
+        std::cerr << "Couldn't write the preset bank " << bankPath << ", keeping it in memory" << std::endl;
+        m_file.Close();
+        Adopt(m_image.data());
+    }
+    return m_numPresets > 0;
+}
+
+size_t PresetBank::GetNumPresets() const noexcept {
+    return m_numPresets;
+}
+
+std::string_view PresetBank::GetName(size_t index) const noexcept {
+    const Entry& entry = GetEntry(index);
+    return std::string_view(entry.name, strnlen(entry.name, sizeof(entry.name)));
+}
+
+std::optional<size_t> PresetBank::Find(std::string_view name) const {
+    auto it = m_indexByName.find(std::string(name));
+    if (it == m_indexByName.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void PresetBank::Load(AudioPreset& preset, size_t index) const noexcept {
+    AudioPreset loaded;
+    std::memcpy(loaded.values.data(), GetEntry(index).values, sizeof(Entry::values));
+
+    for (const ParameterSpec& spec : PARAMETER_SPECS) {
+        if (!spec.isSaved) {
+            loaded[spec.id] = preset[spec.id];
+        }
+    }
+    preset = loaded;
+}
+
+uint64_t PresetBank::HashLayout() {
+    uint64_t hash = s_hashSeed;
+    for (const ParameterSpec& spec : PARAMETER_SPECS) {
+        hash = HashString(hash, spec.key);
+    }
+    return hash;
+}
+
+uint64_t PresetBank::HashSources(const std::vector<fs::path>& jsonFiles) {
+    uint64_t hash = s_hashSeed;
+    for (const fs::path& file : jsonFiles) {
+        std::error_code error;
+        uint64_t size = fs::file_size(file, error);
+        int64_t modified = fs::last_write_time(file, error).time_since_epoch().count();
+
+        hash = HashString(hash, file.filename().string());
+        hash = HashBytes(hash, &size, sizeof(size));
+        hash = HashBytes(hash, &modified, sizeof(modified));
+    }
+    return hash;
+}
+
+std::vector<std::byte> PresetBank::Compile(const std::vector<fs::path>& jsonFiles, uint64_t sourceHash) {
+    std::vector<Entry> entries;
+    entries.reserve(jsonFiles.size());
+
+    for (const fs::path& file : jsonFiles) {
+        std::string name = file.stem().string();
+        if (name.size() > s_maxNameLength) {
+            std::cerr << "Preset name too long, skipping: " << file << std::endl;
+            continue;
+        }
+
+        // Presets start from the defaults, like when loading the JSON file directly
+        AudioPreset preset;
+        if (!AudioPresetIO::LoadFromFile(preset, file.string())) {
+            std::cerr << "Couldn't parse preset, skipping: " << file << std::endl;
+            continue;
+        }
+
+        Entry entry {};
+        std::memcpy(entry.name, name.data(), name.size());
+        std::memcpy(entry.values, preset.values.data(), sizeof(entry.values));
+        entries.push_back(entry);
+    }
+
+    // The files are sorted by path, but the names must be sorted exactly as the GUI lists them
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+
+    Header header {};
+    std::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.version = s_version;
+    header.numParameters = static_cast<uint32_t>(ParameterInfo::NUM_PARAMETERS);
+    header.numPresets = static_cast<uint32_t>(entries.size());
+    header.layoutHash = HashLayout();
+    header.sourceHash = sourceHash;
+
+    std::vector<std::byte> image(sizeof(Header) + entries.size() * sizeof(Entry));
+    std::memcpy(image.data(), &header, sizeof(Header));
+    if (!entries.empty()) {
+        std::memcpy(image.data() + sizeof(Header), entries.data(), entries.size() * sizeof(Entry));
+    }
+    return image;
+}
+
+bool PresetBank::Save(const std::vector<std::byte>& image, const fs::path& bankPath) {
+    fs::path tempPath = bankPath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(tempPath, bankPath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool PresetBank::IsValid(const std::byte *data, size_t size, uint64_t sourceHash) {
+    if (size < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    return std::memcmp(header.magic, s_magic, sizeof(s_magic)) == 0
+        && header.version == s_version
+        && header.numParameters == ParameterInfo::NUM_PARAMETERS
+        && header.layoutHash == HashLayout()
+        && header.sourceHash == sourceHash
+        && size == sizeof(Header) + static_cast<size_t>(header.numPresets) * sizeof(Entry);
+}
+
+void PresetBank::Adopt(const std::byte *data) {
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    m_data = data;
+    m_numPresets = header.numPresets;
+    m_indexByName.reserve(m_numPresets);
+    for (size_t i = 0; i < m_numPresets; i++) {
+        m_indexByName.emplace(std::string(GetName(i)), i);
+    }
+}
+
+const PresetBank::Entry& PresetBank::GetEntry(size_t index) const noexcept {
+    // The mapping is page aligned and both records are multiples of 4 bytes, so every entry is aligned
+    return reinterpret_cast<const Entry*>(m_data + sizeof(Header))[index];
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "preset/AudioPreset.hpp"
+#include "preset/MappedFile.hpp"
+
+// All the built-in presets, compiled from their JSON files into one binary file that is memory
+// mapped, so switching presets is a lookup and a copy of the values, without file I/O or parsing.
+// The JSON files stay the source of truth: the bank records which files (by name, size and
+// modification time) and which parameter layout it was compiled from, and is compiled again
+// whenever either no longer matches.
+class PresetBank {
+public:
+    // Maps the bank at bankPath, compiling it from the *.json files in presetsFolder first if needed.
+    // If the bank can't be written (e.g. a read-only install) it is kept in memory instead.
+    // Returns false if there are no presets to load.
+    bool Open(const std::filesystem::path& presetsFolder, const std::filesystem::path& bankPath);
+
+    size_t GetNumPresets() const noexcept;
+
+    // Sorted by name
+    std::string_view GetName(size_t index) const noexcept;
+    std::optional<size_t> Find(std::string_view name) const;
+
+    // Overwrites the saved parameters of the preset with those of the bank entry,
+    // leaving the others (like the master volume) as they are
+    void Load(AudioPreset& preset, size_t index) const noexcept;
+
+private:
+    // Bump whenever the file layout below changes
+    static constexpr uint32_t s_version = 1;
+    static constexpr size_t s_maxNameLength = 63;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t numParameters;
+        uint32_t numPresets;
+        uint64_t layoutHash; // Of the parameter keys, in order
+        uint64_t sourceHash; // Of the JSON files compiled into the bank
+    };
+
+    // Each preset is a fixed-size record, so entry i sits at a known offset
+    struct Entry {
+        char name[s_maxNameLength + 1]; // Null-terminated
+        float values[ParameterInfo::NUM_PARAMETERS];
+    };
+
+    static constexpr char s_magic[4] = { 'C', 'H', 'P', 'B' };
+
+    static uint64_t HashLayout();
+    static uint64_t HashSources(const std::vector<std::filesystem::path>& jsonFiles);
+
+    // Parses every JSON file into a complete bank image
+    static std::vector<std::byte> Compile(const std::vector<std::filesystem::path>& jsonFiles, uint64_t sourceHash);
+
+    // Writes to a temporary file first, so a crash never leaves half a bank behind
+    static bool Save(const std::vector<std::byte>& image, const std::filesystem::path& bankPath);
+
+    // Checks that the image is a complete bank for these sources and this build
+    static bool IsValid(const std::byte *data, size_t size, uint64_t sourceHash);
+
+    // Points the accessors at a validated image and indexes the names
+    void Adopt(const std::byte *data);
+
+    const Entry& GetEntry(size_t index) const noexcept;
+
+    MappedFile m_file;
+    std::vector<std::byte> m_image; // Only used when the bank couldn't be mapped from disk
+
+    const std::byte *m_data = nullptr;
+    size_t m_numPresets = 0;
+    std::unordered_map<std::string, size_t> m_indexByName;
+};
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "preset/PresetPublisher.hpp"
+
+void PresetPublisher::Publish(const AudioPreset& preset) {
+    // Offer first, which frees any snapshot the audio thread never got around to picking up.
+    // Then free what it has let go of: collected any earlier, the audio thread could retire a
+    // snapshot in between and refuse this one until the next publish, which may never come.
+    m_handoff.Offer(std::make_unique<Snapshot>(Snapshot { preset, m_generation }));
+    m_handoff.CollectRetired();
+}
+
+void PresetPublisher::PublishSwitch(const AudioPreset& preset) {
+    m_generation++;
+    {
+        std::lock_guard<std::mutex> lock(m_switchMutex);
+        m_pendingSwitch = Snapshot { preset, m_generation };
+    }
+
+    // Also as a snapshot, which the engine holds back until the new graph plays. It then
+    // matches the graph already, but replaces any edit published before the switch.
+    Publish(preset);
+}
+
+float PresetPublisher::GetLastCrossfadeLoad() const noexcept {
+    return m_lastCrossfadeLoad.load(std::memory_order_relaxed);
+}
+
+std::optional<PresetPublisher::Snapshot> PresetPublisher::TakeSwitch() {
+    std::lock_guard<std::mutex> lock(m_switchMutex);
+    std::optional<Snapshot> pending = std::move(m_pendingSwitch);
+    m_pendingSwitch.reset();
+    return pending;
+}
+
+const PresetPublisher::Snapshot* PresetPublisher::Fetch() noexcept {
+    return m_handoff.TryAdopt(m_current) ? m_current.get() : nullptr;
+}
+
+void PresetPublisher::ReportCrossfadeLoad(float load) noexcept {
+    m_lastCrossfadeLoad.store(load, std::memory_order_relaxed);
+}
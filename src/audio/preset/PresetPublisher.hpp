@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "preset/AudioPreset.hpp"
+#include "synchronization/ResourceHandoff.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+// Hands immutable preset snapshots from the GUI thread to the audio thread.
+// Publishing swaps in a pointer to a fresh copy, and the audio thread adopts the latest one at
+// the start of a block, so it never sees a preset that is only partly updated. The snapshots the
+// audio thread lets go of are freed by the GUI thread the next time it publishes.
+// Switching to a whole new preset goes through the engine's housekeeping loop instead, which
+// builds a separate synth graph for it to crossfade to (see AudioEngine).
+class PresetPublisher {
+public:
+    struct Snapshot {
+        AudioPreset preset;
+        // Number of switches published up to this snapshot. The engine holds a snapshot back
+        // until the graph of its switch is playing, so an edit made right after a switch
+        // never lands on the old graph.
+        uint64_t generation = 0;
+    };
+
+    // --- GUI thread ---
+
+    // Publishes a copy of the preset, replacing any snapshot the audio thread hasn't picked up yet
+    void Publish(const AudioPreset& preset);
+
+    // Publishes a whole new preset, to be crossfaded to rather than applied in place
+    void PublishSwitch(const AudioPreset& preset);
+
+    // Extra CPU time the last crossfade took, as a fraction of its real-time duration
+    float GetLastCrossfadeLoad() const noexcept;
+
+    // --- Engine housekeeping thread ---
+
+    // Takes the latest switch published since the last call, if any
+    std::optional<Snapshot> TakeSwitch();
+
+    // --- Audio thread (never allocates or frees) ---
+
+    // Returns the latest snapshot if one was published since the last call, otherwise nullptr.
+    // The snapshot stays valid until the next successful call.
+    const Snapshot* Fetch() noexcept;
+
+    void ReportCrossfadeLoad(float load) noexcept;
+
+private:
+    ResourceHandoff<Snapshot> m_handoff;
+    std::unique_ptr<Snapshot> m_current; // Owned by the audio thread
+
+    uint64_t m_generation = 0; // Only touched by the GUI thread
+
+    std::mutex m_switchMutex;
+    std::optional<Snapshot> m_pendingSwitch;
+
+    std::atomic<float> m_lastCrossfadeLoad = 0.0f;
+};
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "preset/PresetSmoother.hpp"
+
+#include <cmath>
+
+void PresetSmoother::SetTarget(const AudioPreset& preset) noexcept {
+    m_target = preset;
+    if (!m_hasTarget) {
+        m_current = preset;
+        m_hasTarget = true;
+    }
+    m_isSettled = m_current == m_target;
+}
+
+void PresetSmoother::SetTarget(ParameterInfo::ID id, float value) noexcept {
+    m_target[id] = value;
+    m_isSettled = m_isSettled && m_current[id] == value;
+}
+
+void PresetSmoother::Reset(const AudioPreset& preset) noexcept {
+    m_target = preset;
+    m_current = preset;
+    m_hasTarget = true;
+    m_isSettled = true;
+}
+
+void PresetSmoother::Advance(double seconds) noexcept {
+    if (m_isSettled) {
+        return;
+    }
+
+    bool settled = true;
+    for (const ParameterSpec& spec : PARAMETER_SPECS) {
+        float target = m_target[spec.id];
+        float& current = m_current[spec.id];
+        if (current == target) {
+            continue;
+        }
+
+        if (spec.smoothingTime <= 0.0f) {
+            current = target;
+            continue;
+        }
+
+        // One-pole glide, so the outcome doesn't depend on how the time is split into steps
+        float coeff = 1.0f - static_cast<float>(std::exp(-seconds / spec.smoothingTime));
+        if (spec.isLogarithmic && current > 0.0f && target > 0.0f) {
+            // Frequencies glide evenly in pitch rather than in Hz
+            current *= std::pow(target / current, coeff);
+        }else {
+            current += (target - current) * coeff;
+        }
+
+        if (std::abs(target - current) <= (spec.maxValue - spec.minValue) * s_settleThreshold) {
+            current = target;
+        }else {
+            settled = false;
+        }
+    }
+    m_isSettled = settled;
+}
+
+const AudioPreset& PresetSmoother::GetCurrent() const noexcept {
+    return m_current;
+}
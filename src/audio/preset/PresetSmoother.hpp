@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "preset/AudioPreset.hpp"
+
+// Audio thread copy of the preset that glides toward the latest published values instead of
+// jumping to them, at the speed given by each parameter's smoothingTime. Parameters that don't
+// smooth (switches, choices, envelope times) follow their target at once.
+class PresetSmoother {
+public:
+    // The first target is taken over as is, so the synth doesn't glide in from the defaults
+    void SetTarget(const AudioPreset& preset) noexcept;
+    void SetTarget(ParameterInfo::ID id, float value) noexcept;
+
+    // Jumps straight to the preset, e.g. when a new synth graph was built for it
+    void Reset(const AudioPreset& preset) noexcept;
+
+    // Moves the current values `seconds` further toward the target
+    void Advance(double seconds) noexcept;
+
+    const AudioPreset& GetCurrent() const noexcept;
+
+private:
+    // A glide ends when it is this close to its target, relative to the parameter's range
+    static constexpr float s_settleThreshold = 1e-5f;
+
+    AudioPreset m_target;
+    AudioPreset m_current;
+    bool m_hasTarget = false;
+    bool m_isSettled = true;
+};
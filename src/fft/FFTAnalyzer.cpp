@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "fft/FFTAnalyzer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace {
+    constexpr size_t s_alignment = 64;
+
+    // Power of a bin at the MIN_DB floor, keeps the log away from zero
+    constexpr float s_minPower = 1e-10f;
+
+    // Approximate log2 for positive, normal floats. Splits the float into exponent and mantissa
+    // and fits log2 of the mantissa with a polynomial. Max error is about 0.005, or 0.015 dB,
+    // and it has no branches so a loop over it vectorizes.
+    inline float FastLog2(float x) noexcept {
+        int32_t bits = std::bit_cast<int32_t>(x);
+        float exponent = static_cast<float>((bits >> 23) - 127);
+        float mantissa = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000); // In [1, 2)
+        return exponent + (-0.34484843f * mantissa + 2.02466578f) * mantissa - 1.67487759f;
+    }
+
+    // Clamps to [0, 1] with integer operations. Float comparisons may trap, so the compiler
+    // won't turn std::clamp into branch-free SIMD code, but the bit patterns of floats sort
+    // the same way as integers (and negative floats are negative integers).
+    inline float ClampToUnit(float x) noexcept {
+        int32_t bits = std::bit_cast<int32_t>(x);
+        bits = std::max(bits, int32_t(0));
+        bits = std::min(bits, std::bit_cast<int32_t>(1.0f));
+        return std::bit_cast<float>(bits);
+    }
+
+    // Same trick for the power floor, valid since powers are never negative
+    inline float ClampToMinPower(float power) noexcept {
+        return std::bit_cast<float>(std::max(std::bit_cast<int32_t>(power), std::bit_cast<int32_t>(s_minPower)));
+    }
+}
+
+void FFTAnalyzer::AlignedDeleter::operator()(float *ptr) const noexcept {
+    ::operator delete[](ptr, std::align_val_t(s_alignment));
+}
+
+FFTAnalyzer::AlignedArray FFTAnalyzer::AllocateAligned(size_t numFloats) {
+    void *memory = ::operator new[](numFloats * sizeof(float), std::align_val_t(s_alignment));
+    AlignedArray array(static_cast<float *>(memory));
+    std::fill(array.get(), array.get() + numFloats, 0.0f);
+    return array;
+}
+
+FFTAnalyzer::FFTAnalyzer(size_t fftSize)
+    : m_fftSize(fftSize)
+    , m_plan(fftSize)
+    , m_window(AllocateAligned(fftSize))
+    , m_spectrum(AllocateAligned(fftSize))
+    , m_power(AllocateAligned(fftSize / 2 + 1))
+{
+    assert(std::has_single_bit(fftSize) && fftSize >= 4 && "FFT size must be a power of two.");
+
+    // Hann window, normalized by its sum so that a full-scale sine reads as 0 dB
+    double windowSum = 0.0;
+    for (size_t n = 0; n < fftSize; n++) {
+        double value = 0.5 * (1.0 - std::cos(2.0 * std::numbers::pi * double(n) / double(fftSize - 1)));
+        m_window[n] = static_cast<float>(value);
+        windowSum += value;
+    }
+    for (size_t n = 0; n < fftSize; n++) {
+        m_window[n] = static_cast<float>(m_window[n] / windowSum);
+    }
+}
+
+size_t FFTAnalyzer::GetFFTSize() const noexcept {
+    return m_fftSize;
+}
+
+size_t FFTAnalyzer::GetNumBins() const noexcept {
+    return m_fftSize / 2 + 1;
+}
+
+void FFTAnalyzer::ComputeMagnitudes(const float *samples, float *magnitudes) {
+    ComputeMagnitudes(samples, 0, magnitudes);
+}
+
+void FFTAnalyzer::ComputeMagnitudes(const float *history, size_t oldestIndex, float *magnitudes) {
+    assert(oldestIndex < m_fftSize);
+
+    // Unwrap the history while windowing, in two contiguous runs
+    float *spectrum = m_spectrum.get();
+    const float *window = m_window.get();
+    const size_t numOlder = m_fftSize - oldestIndex;
+    for (size_t n = 0; n < numOlder; n++) {
+        spectrum[n] = history[oldestIndex + n] * window[n];
+    }
+    for (size_t n = numOlder; n < m_fftSize; n++) {
+        spectrum[n] = history[n - numOlder] * window[n];
+    }
+
+    // Real FFT in place. The result is in halfcomplex order: r0, r1, i1, r2, i2, ..., r(N/2)
+    m_plan.exec(spectrum, 1.0f, true);
+
+    const size_t numBins = GetNumBins();
+    float *power = m_power.get();
+    power[0] = spectrum[0] * spectrum[0];
+    for (size_t k = 1; k < numBins - 1; k++) {
+        float re = spectrum[2 * k - 1];
+        float im = spectrum[2 * k];
+        power[k] = re * re + im * im;
+    }
+    power[numBins - 1] = spectrum[m_fftSize - 1] * spectrum[m_fftSize - 1];
+
+    PowerToNormalizedDB(magnitudes);
+}
+
+void FFTAnalyzer::PowerToNormalizedDB(float *magnitudes) const noexcept {
+    // norm = (10 * log10(power) - MIN_DB) / (MAX_DB - MIN_DB), with the log10 rewritten as a scaled log2
+    const float scale = 10.0f * std::numbers::ln2_v<float> * std::numbers::log10e_v<float> / (MAX_DB - MIN_DB);
+    const float offset = -MIN_DB / (MAX_DB - MIN_DB);
+
+    const float *power = m_power.get();
+    const size_t numBins = GetNumBins();
+    for (size_t k = 0; k < numBins; k++) {
+        float norm = FastLog2(ClampToMinPower(power[k])) * scale + offset;
+        magnitudes[k] = ClampToUnit(norm);
+    }
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "pocketfft_hdronly.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+constexpr float MIN_DB = -100.0f; // floor value for normalization
+constexpr float MAX_DB = 0.0f;    // top of range
+
+// Computes magnitude spectra of fixed-size windows of audio, in dB normalized to [0, 1].
+// Everything that only depends on the FFT size (the pocketfft plan, the Hann window and the
+// scratch buffers) is set up once in the constructor, so repeated analysis doesn't allocate
+// or recompute any tables. Runs in single precision, which is plenty for display purposes.
+class FFTAnalyzer {
+public:
+    // The FFT size must be a power of two
+    explicit FFTAnalyzer(size_t fftSize);
+
+    size_t GetFFTSize() const noexcept;
+
+    // Number of frequency bins produced per analysis, from DC to Nyquist
+    size_t GetNumBins() const noexcept;
+
+    // Analyzes GetFFTSize() samples, oldest first, and writes GetNumBins() magnitudes
+    void ComputeMagnitudes(const float *samples, float *magnitudes);
+
+    // Same, but for a circular history of GetFFTSize() samples where the oldest one is at oldestIndex
+    void ComputeMagnitudes(const float *history, size_t oldestIndex, float *magnitudes);
+
+private:
+    // Scratch memory aligned for SIMD loads
+    struct AlignedDeleter {
+        void operator()(float *ptr) const noexcept;
+    };
+    using AlignedArray = std::unique_ptr<float[], AlignedDeleter>;
+    static AlignedArray AllocateAligned(size_t numFloats);
+
+    // Normalized dB values of the bin powers in m_power, written to magnitudes
+    void PowerToNormalizedDB(float *magnitudes) const noexcept;
+
+    size_t m_fftSize;
+    pocketfft::detail::pocketfft_r<float> m_plan;
+
+    AlignedArray m_window; // Hann window, scaled to compensate for its coherent gain
+    AlignedArray m_spectrum; // Windowed input, transformed in place
+    AlignedArray m_power; // Squared magnitude per bin
+};
@@ -2,78 +2,193 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "FFTComputer.hpp"
-#include "FFTHelper.hpp"
 
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+
+FFTComputer::FFTComputer(size_t fftSize, size_t hopSize, size_t numSpectrogramRows)
+    : m_samples(s_sampleRingCapacity)
+    , m_newSamples(m_samples.GetCapacity())
+    , m_analyzer(fftSize)
+    , m_hopSize(hopSize)
+    , m_analyzedSampleRate(ProcessSpec::DEFAULT_SAMPLE_RATE)
+    , m_columnBuilder(fftSize, m_analyzedSampleRate, numSpectrogramRows)
+    , m_magnitudes(m_analyzer.GetNumBins())
+    , m_levelMeter(m_analyzedSampleRate)
+    , m_history(fftSize, 0.0f)
+    , m_samplesUntilNextFFT(fftSize) // Wait for a full window before the first analysis
+    , m_columns(std::vector<unsigned char>(m_columnBuilder.GetNumRows() * 3))
+{
+    assert(hopSize > 0 && hopSize <= fftSize && "Invalid FFT hop size.");
+}
 
-std::shared_ptr<std::vector<float>> FFTComputer::GetLastFFTResult() const {
-    return m_lastResult.load(std::memory_order_acquire);
+size_t FFTComputer::GetFFTSize() const noexcept {
+    return m_analyzer.GetFFTSize();
 }
 
-std::shared_ptr<AudioFrame> FFTComputer::GetLastAudioLevels() const {
-    return m_lastAudioLevels.load(std::memory_order_acquire);
+size_t FFTComputer::GetHopSize() const noexcept {
+    return m_hopSize;
 }
 
-void FFTComputer::StoreNewFFTResult(std::shared_ptr<std::vector<float>> result) {
-    m_lastResult.store(result, std::memory_order_release);
+void FFTComputer::RequestAnalysis(bool spectrum, bool levels) {
+    if (!spectrum && !levels) {
+        // Nothing on screen, let the analysis go idle
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        m_hasRequest = true;
+        m_spectrumRequested = spectrum;
+        m_levelsRequested = levels;
+    }
+    m_requestCondition.notify_one();
 }
 
-void FFTComputer::StoreNewAudioLevels(AudioFrame result) {
-    m_lastAudioLevels.store(std::make_shared<AudioFrame>(result), std::memory_order_release);
+const std::vector<unsigned char>* FFTComputer::GetNewSpectrogramColumn() {
+    return m_columns.Fetch() ? &m_columns.GetReadBuffer() : nullptr;
+}
+
+AudioLevels FFTComputer::GetLastAudioLevels() {
+    m_audioLevels.Fetch();
+    return m_audioLevels.GetReadBuffer();
+}
+
+float FFTComputer::GetLastPeak() const noexcept {
+    return m_lastPeak.load(std::memory_order_relaxed);
+}
+
+void FFTComputer::StoreNewAudioLevels(const AudioLevels& result) {
+    m_audioLevels.GetWriteBuffer() = result;
+    m_audioLevels.Publish();
 }
 
 void FFTComputer::ProvideAudioBuffer(const AudioBuffer& buffer) {
-    // Copy over the output buffer into a vector we can "produce"
-    std::unique_ptr<std::vector<float>> output = std::make_unique<std::vector<float>>();
-    output->reserve(buffer.numFrames);
-
-    AudioFrame rms{0.0f, 0.0f};
-    for (const AudioFrame& frame : buffer.outputBuffer) {
-        // Sum of squares (RMS)
-        rms.left += frame.left * frame.left;
-        rms.right += frame.right * frame.right;
-        
-        output->push_back((frame.left + frame.right) / 2.0f); // Average across channels
+    if (!m_tapEnabled.load(std::memory_order_relaxed)) {
+        return;
     }
+    // If the FFT thread falls behind, the rest of the buffer is dropped
+    m_samples.Write(buffer.outputBuffer.data(), buffer.numFrames);
+}
 
-    // Mean and root (RMS)
-    rms.left /= static_cast<float>(buffer.numFrames);
-    rms.right /= static_cast<float>(buffer.numFrames);
-    rms.left = std::sqrtf(rms.left);
-    rms.right = std::sqrtf(rms.right);
+void FFTComputer::SetSampleRate(float sampleRate) {
+    m_sampleRate.store(sampleRate, std::memory_order_relaxed);
+}
 
-    StoreNewAudioLevels(rms);
-    m_producerConsumer.Produce(std::move(output));
+void FFTComputer::SetSlowestRequestRate(int requestsPerSecond) {
+    assert(requestsPerSecond > 0 && "The request rate must be positive.");
+    auto frameTimeout = std::chrono::milliseconds(std::lround(1000.0 * s_idleTimeoutFrames / requestsPerSecond));
+    m_idleTimeout = std::max(s_minIdleTimeout, frameTimeout);
 }
 
 void FFTComputer::Start(std::atomic<bool>& running) {
     while (running.load()) {
-        // Continuously collect audio data from the audio engine.
-        // When a large enough window has been collected, compute fft and store result.
-        std::unique_ptr<std::vector<float>> audioToExtend = m_producerConsumer.Consume();
-        if (!audioToExtend) {
-            // The producer has stopped, which means the application has probably closed (running = false)
-            continue;
+        bool spectrum = false;
+        bool levels = false;
+        {
+            std::unique_lock<std::mutex> lock(m_requestMutex);
+            bool requested = m_requestCondition.wait_for(lock, m_idleTimeout, [&]{
+                return m_hasRequest || !running.load();
+            });
+            if (!requested) {
+                lock.unlock();
+                Pause();
+                continue;
+            }
+            if (!m_hasRequest) {
+                // The application is closing
+                break;
+            }
+            m_hasRequest = false;
+            spectrum = m_spectrumRequested;
+            levels = m_levelsRequested;
         }
 
-        // Extend fft buffer with the new audio chunk
-        m_fftBuffer.reserve(m_fftBuffer.size() + distance(audioToExtend->begin(), audioToExtend->end()));
-        m_fftBuffer.insert(m_fftBuffer.end(), audioToExtend->begin(), audioToExtend->end());
+        Analyze(spectrum, levels);
+    }
+}
+
+void FFTComputer::Pause() {
+    m_tapEnabled.store(false, std::memory_order_relaxed);
+    m_lastPeak.store(0.0f, std::memory_order_relaxed);
+    m_isMetering = false;
+}
+
+void FFTComputer::Analyze(bool spectrum, bool levels) {
+    if (!m_tapEnabled.load(std::memory_order_relaxed)) {
+        // Resuming after a pause. Whatever is left in the ring predates the pause, and so does
+        // the history, so start over from fresh audio.
+        m_samples.Discard();
+        m_samplesUntilNextFFT = m_history.size();
+        m_tapEnabled.store(true, std::memory_order_relaxed);
+        return;
+    }
 
-        if (m_fftBuffer.size() > 1024) {
-            std::shared_ptr<std::vector<float>> fft_magnitude = FFTHelper::ComputeFFTMagnitudeDB(m_fftBuffer);
+    float sampleRate = m_sampleRate.load(std::memory_order_relaxed);
+    if (sampleRate != m_analyzedSampleRate) {
+        ApplySampleRate(sampleRate);
+    }
 
-            // Pop oldest audio chunk from the fft buffer
-            m_fftBuffer.erase(m_fftBuffer.begin(), m_fftBuffer.begin() + audioToExtend->size());
-            StoreNewFFTResult(fft_magnitude);
+    size_t numFrames = m_samples.Read(m_newSamples.data(), m_newSamples.size());
+    if (numFrames == 0) {
+        return;
+    }
+
+    float peak = 0.0f;
+    for (size_t i = 0; i < numFrames; i++) {
+        peak = std::max({ peak, std::abs(m_newSamples[i].left), std::abs(m_newSamples[i].right) });
+    }
+    m_lastPeak.store(peak, std::memory_order_relaxed);
+
+    if (levels) {
+        if (!m_isMetering) {
+            // The loudness windows would otherwise span the time the meter was hidden
+            m_levelMeter.Reset();
+            m_isMetering = true;
         }
+        m_levelMeter.Process(m_newSamples.data(), numFrames);
+        StoreNewAudioLevels(m_levelMeter.GetLevels());
+    }else {
+        m_isMetering = false;
     }
 
-    m_producerConsumer.Close();
+    // The history is kept up to date even while the spectrogram is hidden, so that a spectrum
+    // can be computed as soon as it is visible again
+    PushSamples(m_newSamples.data(), numFrames);
+
+    if (spectrum && m_samplesUntilNextFFT == 0) {
+        m_samplesUntilNextFFT = m_hopSize;
+
+        // The next slot to write to holds the oldest sample
+        m_analyzer.ComputeMagnitudes(m_history.data(), m_writeIndex, m_magnitudes.data());
+
+        m_columnBuilder.Build(m_magnitudes.data(), m_columns.GetWriteBuffer().data());
+        m_columns.Publish();
+    }
+}
+
+void FFTComputer::ApplySampleRate(float sampleRate) {
+    // The bins map to other frequencies now, and the loudness filters have other coefficients
+    m_columnBuilder = SpectrogramColumnBuilder(m_analyzer.GetFFTSize(), sampleRate, m_columnBuilder.GetNumRows());
+    m_levelMeter = LevelMeter(sampleRate);
+    m_isMetering = false;
+    m_analyzedSampleRate = sampleRate;
+}
+
+void FFTComputer::PushSamples(const AudioFrame *frames, size_t numFrames) {
+    const size_t mask = m_history.size() - 1; // The FFT size is a power of two
+
+    for (size_t i = 0; i < numFrames; i++) {
+        m_history[m_writeIndex] = (frames[i].left + frames[i].right) / 2.0f; // Average across channels
+        m_writeIndex = (m_writeIndex + 1) & mask;
+    }
+    m_samplesUntilNextFFT -= std::min(numFrames, m_samplesUntilNextFFT);
 }
 
 void FFTComputer::FinishedProducing() {
-    m_producerConsumer.Close();
-}
\ No newline at end of file
+    // Lock so that the notification can't slip in between the FFT thread checking and waiting
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    m_requestCondition.notify_all();
+}
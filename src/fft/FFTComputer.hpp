@@ -3,38 +3,120 @@
 
 #pragma once
 
-#include "synchronization/ProducerConsumer.hpp"
+#include "synchronization/SPSCRingBuffer.hpp"
+#include "synchronization/TripleBuffer.hpp"
+#include "fft/FFTAnalyzer.hpp"
+#include "fft/SpectrogramColumnBuilder.hpp"
+#include "fft/LevelMeter.hpp"
 #include "engine/AudioBackend.hpp"
+#include "engine/ProcessSpec.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 #include <memory>
-#include <mutex>
 #include <utility>
 
+// Analyses the engine output on its own thread: a short-time Fourier transform for the
+// spectrogram, and level and loudness metering.
+// The analysis is pulled by the GUI rather than pushed by the audio thread. Each displayed frame
+// asks for the panels that are visible, and the FFT thread then meters everything that arrived
+// since the previous request and computes one spectrum over the most recent FFT-size samples.
+// The results are turned into display-ready data right away, so the GUI only has to upload bytes.
+// When no requests arrive (the window is minimised, or the panels are collapsed) the thread
+// sleeps and the audio thread stops handing over samples.
 class FFTComputer {
 public:
-    std::shared_ptr<std::vector<float>> GetLastFFTResult() const;
-    std::shared_ptr<AudioFrame> GetLastAudioLevels() const;
+    // The FFT size must be a power of two, and the hop size (the least number of new samples
+    // between two spectra) at most the FFT size
+    FFTComputer(size_t fftSize = 2048, size_t hopSize = 256, size_t numSpectrogramRows = 256);
+
+    size_t GetFFTSize() const noexcept;
+    size_t GetHopSize() const noexcept;
+
+    // Called by the GUI thread once per displayed frame, telling which results are on screen.
+    // The results show up in the getters below a moment later.
+    void RequestAnalysis(bool spectrum, bool levels);
+
+    // Called by the GUI thread. Returns the RGB pixels (highest frequency first) of the latest
+    // spectrogram column if a new one has been computed since the last call, otherwise nullptr.
+    // The pixels stay valid until the next call.
+    const std::vector<unsigned char>* GetNewSpectrogramColumn();
+
+    // Called by the GUI thread. Levels and loudness of the most recent audio, only kept up to
+    // date while the levels are requested.
+    AudioLevels GetLastAudioLevels();
+
+    // Called by the GUI thread. The largest absolute sample of the audio read for the latest
+    // request, whichever results it asked for, and 0 while the analysis is paused. Tells whether
+    // anything is playing without depending on which panels are open.
+    float GetLastPeak() const noexcept;
 
-    // Called by audio thread to produce audio data
+    // Called by the audio thread. Only copies the samples into a lock-free ring, and only while
+    // someone is looking at the results.
     void ProvideAudioBuffer(const AudioBuffer& buffer);
 
-    // Called on a separate FFT thread to consume audio data
+    // Called when the engine's sample rate changes. The FFT thread picks it up on its next analysis.
+    void SetSampleRate(float sampleRate);
+
+    // The lowest rate the GUI keeps requesting at while the results are on screen (its idle frame
+    // rate), so the analysis doesn't pause between two requests. Only before Start().
+    void SetSlowestRequestRate(int requestsPerSecond);
+
+    // Called on a separate FFT thread to serve the analysis requests
     void Start(std::atomic<bool>& running);
 
-    // Forward to the producer consumer that the producer has stopped
+    // Wakes the FFT thread, so that it notices that the application is closing
     void FinishedProducing();
 
 private:
-    void StoreNewFFTResult(std::shared_ptr<std::vector<float>> result);
-    void StoreNewAudioLevels(AudioFrame levels);
+    // Without requests for this long, the analysis pauses. Longer than a frame at the GUI's
+    // idle frame rate, so that a slow but steady stream of requests keeps it running.
+    static constexpr std::chrono::milliseconds s_minIdleTimeout { 250 };
+    static constexpr double s_idleTimeoutFrames = 2.5; // At the slowest request rate
+
+    // Enough for a few displayed frames' worth of audio, in case the GUI stalls
+    static constexpr size_t s_sampleRingCapacity = 16384;
+
+    void Analyze(bool spectrum, bool levels);
+    void ApplySampleRate(float sampleRate);
+    void Pause();
+    void StoreNewAudioLevels(const AudioLevels& levels);
+    void PushSamples(const AudioFrame *frames, size_t numFrames);
+
+    // Audio thread to FFT thread
+    SPSCRingBuffer<AudioFrame> m_samples;
+    std::atomic<bool> m_tapEnabled = false;
+    std::vector<AudioFrame> m_newSamples; // What was read from the ring this time
+    std::atomic<float> m_sampleRate = ProcessSpec::DEFAULT_SAMPLE_RATE;
+
+    // FFT thread to GUI thread
+    std::atomic<float> m_lastPeak = 0.0f;
+    std::chrono::milliseconds m_idleTimeout = s_minIdleTimeout;
+
+    // GUI thread to FFT thread
+    std::mutex m_requestMutex;
+    std::condition_variable m_requestCondition;
+    bool m_hasRequest = false;
+    bool m_spectrumRequested = false;
+    bool m_levelsRequested = false;
 
-    ProducerConsumer<std::vector<float>> m_producerConsumer;
+    FFTAnalyzer m_analyzer;
+    size_t m_hopSize;
+    float m_analyzedSampleRate; // What the column builder and meter were set up for
+    SpectrogramColumnBuilder m_columnBuilder;
+    std::vector<float> m_magnitudes;
 
-    std::vector<float> m_fftBuffer;
+    LevelMeter m_levelMeter;
+    bool m_isMetering = false; // Whether the last request metered the levels
 
-    // Lock free way to regularly update a result while another thread is reading it
-    std::atomic<std::shared_ptr<std::vector<float>>> m_lastResult;
-    std::atomic<std::shared_ptr<AudioFrame>> m_lastAudioLevels;
+    // Circular history of the last FFT-size samples
+    std::vector<float> m_history;
+    size_t m_writeIndex = 0;
+    size_t m_samplesUntilNextFFT;
 
-    std::mutex m_resultMtx;
+    // Wait-free way to regularly update a result while another thread is reading it
+    TripleBuffer<std::vector<unsigned char>> m_columns;
+    TripleBuffer<AudioLevels> m_audioLevels;
 };
\ No newline at end of file
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "fft/LevelMeter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+    // Accumulators for the RMS. Independent partial sums let the compiler use SIMD registers.
+    constexpr size_t s_numLanes = 4;
+
+    // Stage 1 of the K-weighting filter from BS.1770, as an analog prototype
+    // so it can be computed for any sample rate
+    constexpr double s_shelfFrequency = 1681.974450955533;
+    constexpr double s_shelfGainDB = 3.999843853973347;
+    constexpr double s_shelfQ = 0.7071752369554196;
+
+    // Stage 2, the RLB weighting curve
+    constexpr double s_highPassFrequency = 38.13547087602444;
+    constexpr double s_highPassQ = 0.5003270373238773;
+}
+
+LevelMeter::LevelMeter(float sampleRate)
+    : m_blockSize(static_cast<size_t>(std::lround(sampleRate * 0.1f)))
+{
+    KWeighting weighting = ComputeKWeighting(sampleRate);
+    const BiquadCoefficients& shelf = weighting.shelf;
+    m_leftShelf.SetCoefficients(shelf.b0, shelf.b1, shelf.b2, shelf.a1, shelf.a2);
+    m_rightShelf.SetCoefficients(shelf.b0, shelf.b1, shelf.b2, shelf.a1, shelf.a2);
+
+    const BiquadCoefficients& highPass = weighting.highPass;
+    m_leftHighPass.SetCoefficients(highPass.b0, highPass.b1, highPass.b2, highPass.a1, highPass.a2);
+    m_rightHighPass.SetCoefficients(highPass.b0, highPass.b1, highPass.b2, highPass.a1, highPass.a2);
+}
+
+LevelMeter::KWeighting LevelMeter::ComputeKWeighting(float sampleRate) {
+    // Bilinear transforms of the prototypes, in the form that reproduces the coefficients BS.1770
+    // lists for 48 kHz (as libebur128 computes them)
+    KWeighting weighting;
+    {
+        double K = std::tan(std::numbers::pi * s_shelfFrequency / sampleRate);
+        double Vh = std::pow(10.0, s_shelfGainDB / 20.0);
+        double Vb = std::pow(Vh, 0.4996667741545416);
+        double a0 = 1.0 + K / s_shelfQ + K * K;
+
+        weighting.shelf.b0 = (Vh + Vb * K / s_shelfQ + K * K) / a0;
+        weighting.shelf.b1 = 2.0 * (K * K - Vh) / a0;
+        weighting.shelf.b2 = (Vh - Vb * K / s_shelfQ + K * K) / a0;
+        weighting.shelf.a1 = 2.0 * (K * K - 1.0) / a0;
+        weighting.shelf.a2 = (1.0 - K / s_shelfQ + K * K) / a0;
+    }
+
+    // BS.1770 uses an unscaled numerator (1, -2, 1) for the high pass
+    {
+        double K = std::tan(std::numbers::pi * s_highPassFrequency / sampleRate);
+        double a0 = 1.0 + K / s_highPassQ + K * K;
+
+        weighting.highPass.b0 = 1.0;
+        weighting.highPass.b1 = -2.0;
+        weighting.highPass.b2 = 1.0;
+        weighting.highPass.a1 = 2.0 * (K * K - 1.0) / a0;
+        weighting.highPass.a2 = (1.0 - K / s_highPassQ + K * K) / a0;
+    }
+    return weighting;
+}
+
+const LevelMeter::Phases& LevelMeter::GetTruePeakPhases() {
+    static const Phases phases = ComputeTruePeakPhases();
+    return phases;
+}
+
+LevelMeter::Phases LevelMeter::ComputeTruePeakPhases() {
+    // Windowed sinc with its cutoff at the original Nyquist frequency,
+    // 48 taps in total like the example filter in BS.1770
+    Phases phases;
+    constexpr size_t numTaps = s_oversampling * s_tapsPerPhase;
+    for (size_t n = 0; n < numTaps; n++) {
+        double t = (double(n) - (numTaps - 1) / 2.0) / s_oversampling;
+        double sinc = std::sin(std::numbers::pi * t) / (std::numbers::pi * t);
+        double window = 0.42 - 0.5 * std::cos(2.0 * std::numbers::pi * n / (numTaps - 1))
+                      + 0.08 * std::cos(4.0 * std::numbers::pi * n / (numTaps - 1)); // Blackman
+        phases[n % s_oversampling][n / s_oversampling] = static_cast<float>(sinc * window);
+    }
+    for (std::array<float, s_tapsPerPhase>& phase : phases) {
+        // Unity gain for every phase, so a constant signal reads the same at all four points
+        float sum = 0.0f;
+        for (float tap : phase) {
+            sum += tap;
+        }
+        for (float& tap : phase) {
+            tap /= sum;
+        }
+    }
+    return phases;
+}
+
+void LevelMeter::Process(const AudioFrame *frames, size_t numFrames) {
+    if (numFrames == 0) {
+        return;
+    }
+
+    m_levels.rms = ComputeRMS(frames, numFrames);
+
+    AudioFrame peak;
+    for (size_t i = 0; i < numFrames; i++) {
+        peak.left = std::max(peak.left, m_leftPeak.Process(frames[i].left));
+        peak.right = std::max(peak.right, m_rightPeak.Process(frames[i].right));
+    }
+    m_levels.truePeak = peak;
+
+    UpdateLoudness(frames, numFrames);
+}
+
+const AudioLevels& LevelMeter::GetLevels() const noexcept {
+    return m_levels;
+}
+
+void LevelMeter::Reset() noexcept {
+    m_levels = AudioLevels();
+    m_blockEnergies.fill(0.0f);
+    m_blockEnergy = 0.0f;
+    m_samplesInBlock = 0;
+}
+
+AudioFrame LevelMeter::ComputeRMS(const AudioFrame *frames, size_t numFrames) noexcept {
+    // Two frames per step, with the left and right lanes kept apart
+    float acc[s_numLanes] = {};
+    size_t i = 0;
+    for (; i + 1 < numFrames; i += 2) {
+        acc[0] += frames[i].left * frames[i].left;
+        acc[1] += frames[i].right * frames[i].right;
+        acc[2] += frames[i + 1].left * frames[i + 1].left;
+        acc[3] += frames[i + 1].right * frames[i + 1].right;
+    }
+    for (; i < numFrames; i++) {
+        acc[0] += frames[i].left * frames[i].left;
+        acc[1] += frames[i].right * frames[i].right;
+    }
+
+    float n = static_cast<float>(numFrames);
+    return { std::sqrt((acc[0] + acc[2]) / n), std::sqrt((acc[1] + acc[3]) / n) };
+}
+
+void LevelMeter::UpdateLoudness(const AudioFrame *frames, size_t numFrames) {
+    for (size_t i = 0; i < numFrames; i++) {
+        float left = m_leftHighPass.Step(m_leftShelf.Step(frames[i].left));
+        float right = m_rightHighPass.Step(m_rightShelf.Step(frames[i].right));
+        m_blockEnergy += left * left + right * right;
+
+        if (++m_samplesInBlock == m_blockSize) {
+            m_newestBlock = (m_newestBlock + 1) % s_shortTermBlocks;
+            m_blockEnergies[m_newestBlock] = m_blockEnergy / static_cast<float>(m_blockSize);
+            m_blockEnergy = 0.0f;
+            m_samplesInBlock = 0;
+
+            m_levels.momentaryLoudness = EnergyToLUFS(GetMeanEnergy(s_momentaryBlocks));
+            m_levels.shortTermLoudness = EnergyToLUFS(GetMeanEnergy(s_shortTermBlocks));
+        }
+    }
+}
+
+float LevelMeter::GetMeanEnergy(size_t numBlocks) const noexcept {
+    float sum = 0.0f;
+    for (size_t b = 0; b < numBlocks; b++) {
+        sum += m_blockEnergies[(m_newestBlock + s_shortTermBlocks - b) % s_shortTermBlocks];
+    }
+    return sum / static_cast<float>(numBlocks);
+}
+
+float LevelMeter::EnergyToLUFS(float energy) noexcept {
+    if (energy <= 0.0f) {
+        return MIN_LUFS;
+    }
+    return std::max(-0.691f + 10.0f * std::log10(energy), MIN_LUFS);
+}
+
+float LevelMeter::TruePeakDetector::Process(float sample) noexcept {
+    m_history[m_writeIndex] = sample;
+    m_history[m_writeIndex + s_tapsPerPhase] = sample;
+    m_writeIndex = (m_writeIndex + 1) % s_tapsPerPhase;
+    const float *taps = m_history.data() + m_writeIndex; // Oldest first
+
+    // Each phase applied oldest first equals another phase applied newest first (the kernel is
+    // symmetric), so this still visits the same four interpolated points
+    float peak = 0.0f;
+    for (const std::array<float, s_tapsPerPhase>& phase : *m_phases) {
+        float acc[s_numLanes] = {};
+        for (size_t k = 0; k < s_tapsPerPhase; k += s_numLanes) {
+            for (size_t lane = 0; lane < s_numLanes; lane++) {
+                acc[lane] += phase[k + lane] * taps[k + lane];
+            }
+        }
+        peak = std::max(peak, std::abs((acc[0] + acc[1]) + (acc[2] + acc[3])));
+    }
+    return peak;
+}
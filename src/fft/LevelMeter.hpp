@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "engine/AudioFrame.hpp"
+#include "effects/util/BiquadFilter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Floor for the loudness values, reported for silence
+constexpr float MIN_LUFS = -100.0f;
+
+struct AudioLevels {
+    AudioFrame rms;       // Of the most recent audio, linear
+    AudioFrame truePeak;  // Of the most recent audio, linear (may exceed 1)
+    float momentaryLoudness = MIN_LUFS; // LUFS over the last 400 ms
+    float shortTermLoudness = MIN_LUFS; // LUFS over the last 3 s
+};
+
+// Meters stereo audio on the analysis thread: RMS, true peak (4x oversampled as in
+// ITU-R BS.1770 annex 2) and K-weighted BS.1770 momentary and short-term loudness.
+// The loudness windows are built from 100 ms blocks, so they update ten times per second.
+class LevelMeter {
+public:
+    explicit LevelMeter(float sampleRate);
+
+    // Normalized so that a0 = 1
+    struct BiquadCoefficients {
+        double b0 = 1.0;
+        double b1 = 0.0;
+        double b2 = 0.0;
+        double a1 = 0.0;
+        double a2 = 0.0;
+    };
+
+    // The two stages of the BS.1770 K-weighting filter
+    struct KWeighting {
+        BiquadCoefficients shelf;
+        BiquadCoefficients highPass;
+    };
+    static KWeighting ComputeKWeighting(float sampleRate);
+
+    // Meters the next chunk of audio. RMS and true peak are measured over just this chunk.
+    void Process(const AudioFrame *frames, size_t numFrames);
+
+    const AudioLevels& GetLevels() const noexcept;
+
+    // Forgets the loudness history, e.g. when the audio resumes after a gap.
+    // The filter and true peak histories are short enough to settle on their own.
+    void Reset() noexcept;
+
+private:
+    static constexpr size_t s_oversampling = 4;
+    static constexpr size_t s_tapsPerPhase = 12;
+    static constexpr size_t s_momentaryBlocks = 4;  // 400 ms
+    static constexpr size_t s_shortTermBlocks = 30; // 3 s
+
+    using Phases = std::array<std::array<float, s_tapsPerPhase>, s_oversampling>;
+
+    // Finds the largest absolute value among the 4x upsampled points of one channel
+    class TruePeakDetector {
+    public:
+        float Process(float sample) noexcept;
+
+    private:
+        const Phases *m_phases = &GetTruePeakPhases(); // Shared, so copies stay valid
+
+        // Every sample is written twice so the latest taps are always contiguous
+        std::array<float, 2 * s_tapsPerPhase> m_history {};
+        size_t m_writeIndex = 0;
+    };
+
+    // Interpolation filter for the true peak, split into its four phases.
+    // The same for every meter, so it's computed once.
+    static const Phases& GetTruePeakPhases();
+    static Phases ComputeTruePeakPhases();
+
+    static AudioFrame ComputeRMS(const AudioFrame *frames, size_t numFrames) noexcept;
+    static float EnergyToLUFS(float energy) noexcept;
+
+    void UpdateLoudness(const AudioFrame *frames, size_t numFrames);
+    float GetMeanEnergy(size_t numBlocks) const noexcept;
+
+    AudioLevels m_levels;
+
+    TruePeakDetector m_leftPeak;
+    TruePeakDetector m_rightPeak;
+
+    // K-weighting: a high shelf for the head, then a high pass
+    BiquadFilter m_leftShelf;
+    BiquadFilter m_rightShelf;
+    BiquadFilter m_leftHighPass;
+    BiquadFilter m_rightHighPass;
+
+    size_t m_blockSize;
+    size_t m_samplesInBlock = 0;
+    float m_blockEnergy = 0.0f; // Sum of squares of both channels in the current block
+
+    // Mean square per completed block, for the short-term window (which includes the momentary one)
+    std::array<float, s_shortTermBlocks> m_blockEnergies {};
+    size_t m_newestBlock = 0;
+};
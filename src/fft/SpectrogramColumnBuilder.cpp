@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "fft/SpectrogramColumnBuilder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+SpectrogramColumnBuilder::SpectrogramColumnBuilder(size_t fftSize, float sampleRate, size_t numRows,
+                                                   float minFrequency, SpectrumReduction::Type reduction)
+    : m_reduction(reduction)
+    , m_rows(numRows)
+{
+    assert(numRows > 0 && minFrequency > 0.0f && minFrequency < sampleRate / 2.0f);
+
+    const size_t lastBin = fftSize / 2;
+    const double binWidth = static_cast<double>(sampleRate) / static_cast<double>(fftSize);
+    const double maxFrequency = sampleRate / 2.0;
+    const double ratio = maxFrequency / minFrequency;
+
+    for (size_t r = 0; r < numRows; r++) {
+        // Edges and centre of the row on a log frequency axis, measured in bins
+        double low = minFrequency * std::pow(ratio, double(r) / double(numRows)) / binWidth;
+        double high = minFrequency * std::pow(ratio, double(r + 1) / double(numRows)) / binWidth;
+        double centre = std::sqrt(low * high);
+
+        size_t first = static_cast<size_t>(std::ceil(low));
+        size_t last = std::min(static_cast<size_t>(std::floor(high)), lastBin);
+
+        RowMapping& row = m_rows[r];
+        if (first <= last) {
+            // At least one bin centre falls within the row
+            row.firstBin = static_cast<uint32_t>(first);
+            row.numBins = static_cast<uint32_t>(last - first + 1);
+            row.fraction = 0.0f;
+        }else {
+            size_t below = std::min(static_cast<size_t>(centre), lastBin - 1);
+            row.firstBin = static_cast<uint32_t>(below);
+            row.numBins = 0;
+            row.fraction = static_cast<float>(std::clamp(centre - double(below), 0.0, 1.0));
+        }
+    }
+}
+
+size_t SpectrogramColumnBuilder::GetNumRows() const noexcept {
+    return m_rows.size();
+}
+
+void SpectrogramColumnBuilder::Build(const float *magnitudes, unsigned char *pixels) const noexcept {
+    const std::array<Colour, PALETTE_SIZE>& palette = GetPalette();
+    const size_t numRows = m_rows.size();
+
+    for (size_t r = 0; r < numRows; r++) {
+        float mag = ReduceRow(m_rows[r], magnitudes);
+        size_t index = static_cast<size_t>(std::clamp(mag, 0.0f, 1.0f) * (PALETTE_SIZE - 1) + 0.5f);
+
+        // The top of the image is the highest frequency
+        unsigned char *pixel = pixels + (numRows - r - 1) * 3;
+        pixel[0] = palette[index][0];
+        pixel[1] = palette[index][1];
+        pixel[2] = palette[index][2];
+    }
+}
+
+float SpectrogramColumnBuilder::ReduceRow(const RowMapping& row, const float *magnitudes) const noexcept {
+    const float *bins = magnitudes + row.firstBin;
+    if (row.numBins == 0) {
+        return bins[0] + row.fraction * (bins[1] - bins[0]);
+    }
+
+    if (m_reduction == SpectrumReduction::Type::Peak) {
+        return *std::max_element(bins, bins + row.numBins);
+    }
+
+    float sum = 0.0f;
+    for (uint32_t k = 0; k < row.numBins; k++) {
+        sum += bins[k];
+    }
+    return sum / static_cast<float>(row.numBins);
+}
+
+const std::array<SpectrogramColumnBuilder::Colour, SpectrogramColumnBuilder::PALETTE_SIZE>& SpectrogramColumnBuilder::GetPalette() {
+    static const std::array<Colour, PALETTE_SIZE> palette = []() {
+        std::array<Colour, PALETTE_SIZE> colours;
+        for (size_t i = 0; i < PALETTE_SIZE; i++) {
+            colours[i] = MagnitudeToRGB(static_cast<float>(i) / static_cast<float>(PALETTE_SIZE - 1));
+        }
+        return colours;
+    }();
+    return palette;
+}
+
+SpectrogramColumnBuilder::Colour SpectrogramColumnBuilder::MagnitudeToRGB(float mag)
+{
+    mag *= 2;
+    mag = std::clamp(mag, 0.0f, 1.0f);
+
+    // Define 3 anchor colors (in linear RGB)
+    const float c0[3] = { 0x05 / 255.0f, 0x09 / 255.0f, 0x13 / 255.0f }; // very dark
+    const float c1[3] = { 0x11 / 255.0f, 0x26 / 255.0f, 0x5C / 255.0f }; // base (#11265C)
+    const float c2[3] = { 0x6B / 255.0f, 0xC9 / 255.0f, 0xFF / 255.0f }; // highlight
+
+    float r_f, g_f, b_f;
+
+    if (mag < 0.5f) {
+        // interpolate c0 → c1
+        float t = mag / 0.5f;
+        r_f = (1 - t) * c0[0] + t * c1[0];
+        g_f = (1 - t) * c0[1] + t * c1[1];
+        b_f = (1 - t) * c0[2] + t * c1[2];
+    } else {
+        // interpolate c1 → c2
+        float t = (mag - 0.5f) / 0.5f;
+        r_f = (1 - t) * c1[0] + t * c2[0];
+        g_f = (1 - t) * c1[1] + t * c2[1];
+        b_f = (1 - t) * c1[2] + t * c2[2];
+    }
+
+    return {
+        (unsigned char)(std::clamp(r_f, 0.0f, 1.0f) * 255),
+        (unsigned char)(std::clamp(g_f, 0.0f, 1.0f) * 255),
+        (unsigned char)(std::clamp(b_f, 0.0f, 1.0f) * 255)
+    };
+}
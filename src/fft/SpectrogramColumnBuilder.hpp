@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SpectrumReduction {
+    // How the FFT bins that fall within one display row are combined
+    enum class Type {
+        Peak,   // Loudest bin, keeps narrow peaks visible
+        Average // Mean of the bins, smoother at high frequencies
+    };
+}
+
+// Turns normalized FFT magnitudes into a display-ready spectrogram column: one RGB pixel per row,
+// highest frequency first, with the rows spaced logarithmically in frequency so every octave gets
+// the same height. The bin-to-row mapping and the colour palette are computed once up front,
+// so building a column is only lookups and comparisons.
+class SpectrogramColumnBuilder {
+public:
+    static constexpr size_t PALETTE_SIZE = 256;
+    using Colour = std::array<unsigned char, 3>;
+
+    SpectrogramColumnBuilder(size_t fftSize, float sampleRate, size_t numRows,
+                             float minFrequency = 20.0f,
+                             SpectrumReduction::Type reduction = SpectrumReduction::Type::Peak);
+
+    size_t GetNumRows() const noexcept;
+
+    // Maps fftSize / 2 + 1 magnitudes in [0, 1] to 3 * GetNumRows() bytes of RGB
+    void Build(const float *magnitudes, unsigned char *pixels) const noexcept;
+
+    // Colour for each quantized magnitude, index 0 is silence
+    static const std::array<Colour, PALETTE_SIZE>& GetPalette();
+
+private:
+    // The bins behind one row. Rows narrower than a bin (at low frequencies)
+    // interpolate between firstBin and firstBin + 1 instead.
+    struct RowMapping {
+        uint32_t firstBin;
+        uint32_t numBins; // 0 means interpolate
+        float fraction;
+    };
+
+    static Colour MagnitudeToRGB(float mag);
+
+    float ReduceRow(const RowMapping& row, const float *magnitudes) const noexcept;
+
+    SpectrumReduction::Type m_reduction;
+    std::vector<RowMapping> m_rows; // Lowest frequency first
+};
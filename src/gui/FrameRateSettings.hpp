@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+// How often the interface is redrawn
+struct FrameRateSettings {
+    int maxFPS = 60;  // While interacting, or while there is sound to visualise
+    int idleFPS = 10; // Otherwise
+};
@@ -10,12 +10,22 @@
 #include "preset/BuiltInPresetsLoader.hpp"
 #include "modulation/LFO.hpp"
 #include <utility>
+#include <algorithm>
 #include <iostream>
 
 // RAII class for managing the GLFW window
-GUIManager::GUIManager(std::shared_ptr<AudioPreset> preset, std::shared_ptr<FFTComputer> fftComputer)
-    : m_preset(preset)
-    , m_fftComputer(fftComputer) {
+GUIManager::GUIManager(std::vector<std::shared_ptr<PresetPublisher>> partPresets, std::shared_ptr<PartRoutingTable> routing,
+                       std::shared_ptr<FFTComputer> fftComputer, std::shared_ptr<EngineEventQueue> events,
+                       FrameRateSettings frameRates)
+    : m_routing(routing)
+    , m_presets(partPresets.at(0))
+    , m_fftComputer(fftComputer)
+    , m_events(events)
+    , m_frameRates(frameRates) {
+    for (const std::shared_ptr<PresetPublisher>& publisher : partPresets) {
+        m_parts.push_back({ publisher, AudioPreset(), AudioPreset() });
+    }
+
     m_window = InitAux();
     if (m_window == nullptr) {
         std::cerr << "Couldn't initialize window\n";
@@ -39,16 +49,14 @@ void GUIManager::RunMainLoop() {
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite your copy of the keyboard data.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
-        glfwPollEvents();
+        WaitForNextFrame();
         if (glfwGetWindowAttrib(m_window, GLFW_ICONIFIED) != 0)
         {
-            ImGui_ImplGlfw_Sleep(10);
+            // Nothing to draw until the window is restored, which wakes this up
+            glfwWaitEvents();
             continue;
         }
 
-        // Handle key input BEFORE starting new ImGui frame
-        HandleKeyboardInput();
-
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -57,17 +65,26 @@ void GUIManager::RunMainLoop() {
         // 2. Show a simple window that we create ourselves. We use a Begin/End pair to create a named window.
         {
             DrawPresetControlWindow();
+            PublishPresetChanges();
 
-            std::shared_ptr<std::vector<float>> column = m_fftComputer->GetLastFFTResult();
+            const std::vector<unsigned char>* column = m_fftComputer->GetNewSpectrogramColumn();
             if (column != nullptr) {
-                m_spectrogram.PushColumn(*column.get());
-                m_spectrogram.Show();
+                m_spectrogram.PushColumn(*column);
             }
+            bool spectrogramVisible = m_spectrogram.Show();
+
+            AudioLevels levels = m_fftComputer->GetLastAudioLevels();
+            m_levelsDisplay.UpdateLevels(levels);
+            bool levelsVisible = m_levelsDisplay.Show();
+
+            // Ask for the next results, for just the panels that are on screen. The analysis
+            // thereby runs at the display rate, and pauses while minimised (see the loop start).
+            m_fftComputer->RequestAnalysis(spectrogramVisible, levelsVisible);
 
-            std::shared_ptr<AudioFrame> levels = m_fftComputer->GetLastAudioLevels();
-            if (levels != nullptr) {
-                m_levelsDisplay.UpdateLevels(*levels.get());
-                m_levelsDisplay.Show();
+            // Visualised sound keeps the frame rate up, silence lets it drop
+            bool audible = m_fftComputer->GetLastPeak() > s_silenceThreshold;
+            if ((spectrogramVisible || levelsVisible) && audible) {
+                m_lastActivityTime = glfwGetTime();
             }
         }
 
@@ -83,229 +100,147 @@ void GUIManager::RunMainLoop() {
     }
 }
 
-void GUIManager::DrawPresetControlWindow() {
-    ImGui::Begin("Preset control"); // Create a window
-
-    ImGui::SeparatorText("Global settings");
+void GUIManager::SetPreset(const AudioPreset& preset) {
+    size_t selectedPart = m_selectedPart;
+    for (size_t part = 0; part < m_parts.size(); part++) {
+        SelectPart(part);
+        m_preset = preset;
+        PublishPresetChanges();
+    }
+    SelectPart(selectedPart);
+}
 
-    float volumeTemp = m_preset->synthMasterVolume.load();
-    ImGui::SliderFloat("Master volume", &volumeTemp, 0.0f, 1.0f);
-    m_preset->synthMasterVolume.store(volumeTemp);
+void GUIManager::SelectPart(size_t part) {
+    m_parts[m_selectedPart].preset = m_preset;
+    m_parts[m_selectedPart].publishedPreset = m_publishedPreset;
 
+    m_selectedPart = part;
+    m_presets = m_parts[part].publisher;
+    m_preset = m_parts[part].preset;
+    m_publishedPreset = m_parts[part].publishedPreset;
+}
 
-    DrawPresetControls();
+void GUIManager::PublishPresetChanges() {
+    if (m_preset == m_publishedPreset) {
+        return;
+    }
+    m_presets->Publish(m_preset);
+    m_publishedPreset = m_preset;
+}
 
+void GUIManager::PublishPresetSwitch() {
+    m_presets->PublishSwitch(m_preset);
+    m_publishedPreset = m_preset;
+}
 
-    ImGui::SeparatorText("Oscillator A");
-    
-    bool oscAOnTemp = m_preset->synthOscAOn.load();
-    ImGui::Checkbox("On##A", &oscAOnTemp);
-    m_preset->synthOscAOn.store(oscAOnTemp);
-    
-    // --- Waveform dropdown ---
-    WaveformInfo::Type waveformATemp = m_preset->synthOscAWaveform.load();
-
-    // ImGui::Combo returns true if the selection changed
-    if (ImGui::BeginCombo("Waveform##A", WaveformInfo::Names[static_cast<int>(waveformATemp)])) {
-        for (int n = 0; n < IM_ARRAYSIZE(WaveformInfo::Names); n++) {
-            bool isSelected = (static_cast<int>(waveformATemp) == n);
-            if (ImGui::Selectable(WaveformInfo::Names[n], isSelected))
-                waveformATemp = static_cast<WaveformInfo::Type>(n);
-            if (isSelected)
-                ImGui::SetItemDefaultFocus();
+void GUIManager::WaitForNextFrame() {
+    // Waiting rather than polling leaves the CPU to the audio and analysis threads.
+    // Input wakes this up early, and then switches to the full frame rate.
+    double now = glfwGetTime();
+    double nextFrameTime = m_lastFrameTime + GetFrameInterval(now);
+    while (now < nextFrameTime) {
+        glfwWaitEventsTimeout(nextFrameTime - now);
+        now = glfwGetTime();
+        if (now < nextFrameTime - 0.001) {
+            // Woken before the timeout (with some slack for timer granularity), so by an event
+            m_lastActivityTime = now;
         }
-        ImGui::EndCombo();
+        nextFrameTime = m_lastFrameTime + GetFrameInterval(now);
     }
-    m_preset->synthOscAWaveform.store(waveformATemp);
-    // ---
-
-    float oscAVolumeTemp = m_preset->synthOscAVolume.load();
-    ImGui::SliderFloat("Volume##A", &oscAVolumeTemp, 0.0f, 1.0f);
-    m_preset->synthOscAVolume.store(oscAVolumeTemp);
-
-    float oscAPanTemp = m_preset->synthOscAPan.load();
-    ImGui::SliderFloat("Pan##A", &oscAPanTemp, 0.0f, 1.0f);
-    m_preset->synthOscAPan.store(oscAPanTemp);
-
-    int oscAOctaveTemp = m_preset->synthOscAOctave.load();
-    ImGui::SliderInt("Octave##A", &oscAOctaveTemp, 1, 7);
-    m_preset->synthOscAOctave.store(oscAOctaveTemp);
-
-
-    ImGui::SeparatorText("Oscillator B");
-    
-    bool oscBOnTemp = m_preset->synthOscBOn.load();
-    ImGui::Checkbox("On##B", &oscBOnTemp);
-    m_preset->synthOscBOn.store(oscBOnTemp);
-    
-    // --- Waveform dropdown ---
-    WaveformInfo::Type waveformBTemp = m_preset->synthOscBWaveform.load();
-
-    // ImGui::Combo returns true if the selection changed
-    if (ImGui::BeginCombo("Waveform##B", WaveformInfo::Names[static_cast<int>(waveformBTemp)])) {
-        for (int n = 0; n < IM_ARRAYSIZE(WaveformInfo::Names); n++) {
-            bool isSelected = (static_cast<int>(waveformBTemp) == n);
-            if (ImGui::Selectable(WaveformInfo::Names[n], isSelected))
-                waveformBTemp = static_cast<WaveformInfo::Type>(n);
-            if (isSelected)
-                ImGui::SetItemDefaultFocus();
+    m_lastFrameTime = now;
+}
+
+void GUIManager::DrawPartControls() {
+    ImGui::SeparatorText("Part");
+
+    std::string partLabel = std::format("Part {}", m_selectedPart + 1);
+    if (ImGui::BeginCombo("Edit part", partLabel.c_str())) {
+        for (size_t part = 0; part < m_parts.size(); part++) {
+            std::string label = std::format("Part {}", part + 1);
+            if (ImGui::Selectable(label.c_str(), part == m_selectedPart)) {
+                SelectPart(part);
+            }
         }
         ImGui::EndCombo();
     }
-    m_preset->synthOscBWaveform.store(waveformBTemp);
-    // ---
-
-    float oscBVolumeTemp = m_preset->synthOscBVolume.load();
-    ImGui::SliderFloat("Volume##B", &oscBVolumeTemp, 0.0f, 1.0f);
-    m_preset->synthOscBVolume.store(oscBVolumeTemp);
-
-    float oscBPanTemp = m_preset->synthOscBPan.load();
-    ImGui::SliderFloat("Pan##B", &oscBPanTemp, 0.0f, 1.0f);
-    m_preset->synthOscBPan.store(oscBPanTemp);
-
-    int oscBOctaveTemp = m_preset->synthOscBOctave.load();
-    ImGui::SliderInt("Octave##B", &oscBOctaveTemp, 1, 7);
-    m_preset->synthOscBOctave.store(oscBOctaveTemp);
-
-    
-    ImGui::SeparatorText("Volume envelope");
-
-    // --- Attack ---
-    float oscAttackTemp = m_preset->synthOscAttack.load();
-    ImGui::SliderFloat("Attack (s)##vol", &oscAttackTemp, 0.0f, 2.0f);
-    m_preset->synthOscAttack.store(oscAttackTemp);
-
-    // --- Hold ---
-    float oscHoldTemp = m_preset->synthOscHold.load();
-    ImGui::SliderFloat("Hold (s)##vol", &oscHoldTemp, 0.0f, 2.0f);
-    m_preset->synthOscHold.store(oscHoldTemp);
-
-    // --- Decay ---
-    float oscDecTemp = m_preset->synthOscDec.load();
-    ImGui::SliderFloat("Decay (s)##vol", &oscDecTemp, 0.0f, 2.0f);
-    m_preset->synthOscDec.store(oscDecTemp);
-
-    // --- Sustain ---
-    float oscSusTemp = m_preset->synthOscSus.load();
-    ImGui::SliderFloat("Sustain (level)##vol", &oscSusTemp, 0.0f, 1.0f);
-    m_preset->synthOscSus.store(oscSusTemp);
-
-    // --- Release ---
-    float oscRelTemp = m_preset->synthOscRel.load();
-    ImGui::SliderFloat("Release (s)##vol", &oscRelTemp, 0.0f, 4.0f);
-    m_preset->synthOscRel.store(oscRelTemp);
-
-
-    ImGui::SeparatorText("Low-pass filter");
-
-    bool lpFilterOnTemp = m_preset->synthLpFilterOn.load();
-    ImGui::Checkbox("On##LP", &lpFilterOnTemp);
-    m_preset->synthLpFilterOn.store(lpFilterOnTemp);
 
-    float lpFilterMixTemp = m_preset->synthLpFilterMix.load();
-    ImGui::SliderFloat("Mix##LP", &lpFilterMixTemp, 0.0f, 1.0f);
-    m_preset->synthLpFilterMix.store(lpFilterMixTemp);
+    PartRouting routing = m_routing->Get(m_selectedPart);
+    bool changed = ImGui::Checkbox("Part on", &routing.isOn);
 
-    float lpFilterCutoffTemp = m_preset->synthLpFilterCutoff.load();
-    ImGui::SliderFloat("Cutoff frequency (Hz)##LP", &lpFilterCutoffTemp,
-                    20.0f, 20000.0f, "%.1f Hz", ImGuiSliderFlags_Logarithmic);
-    m_preset->synthLpFilterCutoff.store(lpFilterCutoffTemp);
-
-    float lpFilterQTemp = m_preset->synthLpFilterQ.load();
-    ImGui::SliderFloat("Peaking/Q##LP", &lpFilterQTemp, 0.1f, 3.0f);
-    m_preset->synthLpFilterQ.store(lpFilterQTemp);
-
-
-    ImGui::SeparatorText("Low-pass filter cutoff envelope");
-    
-    float oscLpCutoffAttackTemp = m_preset->synthOscLpCutoffAttack.load();
-    ImGui::SliderFloat("Attack (s)##cut", &oscLpCutoffAttackTemp, 0.0f, 2.0f);
-    m_preset->synthOscLpCutoffAttack.store(oscLpCutoffAttackTemp);
-
-    float oscLpCutoffDecTemp = m_preset->synthOscLpCutoffDec.load();
-    ImGui::SliderFloat("Decay (s)##cut", &oscLpCutoffDecTemp, 0.0f, 2.0f);
-    m_preset->synthOscLpCutoffDec.store(oscLpCutoffDecTemp);
-
-    float oscLpCutoffAmountTemp = m_preset->synthOscLpCutoffAmount.load();
-    ImGui::SliderFloat("Amount (semitones)##cut", &oscLpCutoffAmountTemp, -60.0f, 60.0f);
-    m_preset->synthOscLpCutoffAmount.store(oscLpCutoffAmountTemp);
-
-
-    ImGui::SeparatorText("High-pass filter");
-
-    bool hpFilterOnTemp = m_preset->synthHpFilterOn.load();
-    ImGui::Checkbox("On##HP", &hpFilterOnTemp);
-    m_preset->synthHpFilterOn.store(hpFilterOnTemp);
-
-    float hpFilterMixTemp = m_preset->synthHpFilterMix.load();
-    ImGui::SliderFloat("Mix##HP", &hpFilterMixTemp, 0.0f, 1.0f);
-    m_preset->synthHpFilterMix.store(hpFilterMixTemp);
-
-    float hpFilterCutoffTemp = m_preset->synthHpFilterCutoff.load();
-    ImGui::SliderFloat("Cutoff frequency (Hz) ##HP", &hpFilterCutoffTemp,
-                    20.0f, 20000.0f, "%.1f Hz", ImGuiSliderFlags_Logarithmic);
-    m_preset->synthHpFilterCutoff.store(hpFilterCutoffTemp);
-
-    float hpFilterQTemp = m_preset->synthHpFilterQ.load();
-    ImGui::SliderFloat("HP Peaking/Q##HP", &hpFilterQTemp, 0.1f, 3.0f);
-    m_preset->synthHpFilterQ.store(hpFilterQTemp);
-
-    
-    ImGui::SeparatorText("Feedback delay");
-
-    bool delayOnTemp = m_preset->synthDelayOn.load();
-    ImGui::Checkbox("On##Delay", &delayOnTemp);
-    m_preset->synthDelayOn.store(delayOnTemp);
-
-    // --- Delay type dropdown --- 
-    FeedbackDelayInfo::Type delayTypeTemp = m_preset->synthDelayType.load();
-
-    if (ImGui::BeginCombo("Delay mode", FeedbackDelayInfo::Names[static_cast<int>(delayTypeTemp)])) {
-        for (int n = 0; n < IM_ARRAYSIZE(FeedbackDelayInfo::Names); n++) {
-            bool isSelected = (static_cast<int>(delayTypeTemp) == n);
-            if (ImGui::Selectable(FeedbackDelayInfo::Names[n], isSelected)) {
-                delayTypeTemp = static_cast<FeedbackDelayInfo::Type>(n);
-            }
-            if (isSelected) {
-                ImGui::SetItemDefaultFocus();
+    // Shown as 1 to 16, like MIDI channels. The keyboard plays on channel 1.
+    std::string channelLabel = routing.channel == PartRouting::ANY_CHANNEL ? "Any" : std::to_string(routing.channel + 1);
+    if (ImGui::BeginCombo("Channel", channelLabel.c_str())) {
+        if (ImGui::Selectable("Any", routing.channel == PartRouting::ANY_CHANNEL)) {
+            routing.channel = PartRouting::ANY_CHANNEL;
+            changed = true;
+        }
+        for (uint8_t channel = 0; channel < 16; channel++) {
+            if (ImGui::Selectable(std::to_string(channel + 1).c_str(), routing.channel == channel)) {
+                routing.channel = channel;
+                changed = true;
             }
         }
         ImGui::EndCombo();
     }
-    m_preset->synthDelayType.store(delayTypeTemp);
-
-    float delayMixTemp = m_preset->synthDelayMix.load();
-    ImGui::SliderFloat("Mix##Delay", &delayMixTemp, 0.0f, 1.0f);
-    m_preset->synthDelayMix.store(delayMixTemp);
 
-    float delayTimeTemp = m_preset->synthDelayTime.load();
-    ImGui::SliderFloat("Delay time (s)##Delay", &delayTimeTemp, FeedbackDelayLine::MIN_DELAY_SEC, FeedbackDelayLine::MAX_DELAY_SEC);
-    m_preset->synthDelayTime.store(delayTimeTemp);
-
-    float delayFeedbackTemp = m_preset->synthDelayFeedback.load();
-    ImGui::SliderFloat("Feedback level##Delay", &delayFeedbackTemp, FeedbackDelayLine::MIN_FEEDBACK, FeedbackDelayLine::MAX_FEEDBACK);
-    m_preset->synthDelayFeedback.store(delayFeedbackTemp);
+    // The range the keyboard plays
+    const int minKey = Note(Key::A, s_minOctave).GetIndex();
+    const int maxKey = Note(Key::Gs, s_maxOctave).GetIndex();
+    int lowestKey = std::clamp<int>(routing.lowestKey, minKey, maxKey);
+    int highestKey = std::clamp<int>(routing.highestKey, minKey, maxKey);
+    changed |= ImGui::SliderInt("Lowest key", &lowestKey, minKey, maxKey, GetNoteName(lowestKey).c_str());
+    changed |= ImGui::SliderInt("Highest key", &highestKey, minKey, maxKey, GetNoteName(highestKey).c_str());
+
+    if (changed) {
+        routing.lowestKey = static_cast<uint8_t>(lowestKey);
+        routing.highestKey = static_cast<uint8_t>(std::max(lowestKey, highestKey));
+        m_routing->Set(m_selectedPart, routing);
+    }
+}
 
+std::string GUIManager::GetNoteName(int noteIndex) {
+    static constexpr const char *keyNames[] = { "A", "A#", "B", "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#" };
+    return std::format("{}{}", keyNames[noteIndex % 12], noteIndex / 12);
+}
 
-    ImGui::SeparatorText("Reverb settings");
+double GUIManager::GetFrameInterval(double now) const {
+    bool active = now - m_lastActivityTime < s_activityHoldTime;
+    int fps = active ? m_frameRates.maxFPS : m_frameRates.idleFPS;
+    return 1.0 / std::max(fps, 1);
+}
 
-    bool reverbOnTemp = m_preset->synthReverbOn.load();
-    ImGui::Checkbox("On##Reverb", &reverbOnTemp);
-    m_preset->synthReverbOn.store(reverbOnTemp);
+void GUIManager::DrawPresetControlWindow() {
+    ImGui::Begin("Preset control"); // Create a window
 
-    float reverbFeedbackTemp = m_preset->synthReverbFeedback.load();
-    ImGui::SliderFloat("Feedback level##Reverb", &reverbFeedbackTemp, 0.0f, 0.8f);
-    m_preset->synthReverbFeedback.store(reverbFeedbackTemp);
+    DrawPartControls();
+
+    ImGui::SeparatorText(ParameterInfo::TargetNames[static_cast<size_t>(ParameterInfo::Target::Master)]);
+    DrawParameter(ParameterInfo::ID::MasterVolume);
+
+    ImGui::Text("Keyboard octave: %d (change with , and .)", m_octave);
+    ImGui::Text("Key to sound latency: %.1f ms (max %.1f ms)",
+                m_events->GetLastLatencyMs(), m_events->GetMaxLatencyMs());
+    OutputStreamInfo stream = m_events->GetOutputStreamInfo();
+    if (stream.sampleRate > 0.0f) {
+        std::string frames = stream.framesPerBuffer > 0 ? std::to_string(stream.framesPerBuffer) : "variable";
+        ImGui::Text("Audio output: %.0f Hz, %s frames per buffer, %.1f ms latency",
+                    stream.sampleRate, frames.c_str(), stream.latencyMs);
+    }else {
+        ImGui::Text("Audio output: not running");
+    }
+    ImGui::Text("Preset crossfade: +%.1f%% CPU (last switch)", m_presets->GetLastCrossfadeLoad() * 100.0f);
 
-    float reverbDampTemp = m_preset->synthReverbDamp.load();
-    ImGui::SliderFloat("Damp level##Reverb", &reverbDampTemp, 0.0f, 1.0f);
-    m_preset->synthReverbDamp.store(reverbDampTemp);
+    DrawPresetControls();
 
-    float reverbWetTemp = m_preset->synthReverbWet.load();
-    ImGui::SliderFloat("Wet level / Mix##Reverb", &reverbWetTemp, 0.0f, 1.0f);
-    m_preset->synthReverbWet.store(reverbWetTemp);
+    // A section of widgets per part of the synth, straight from the parameter registry.
+    // The LFOs only show the settings of their current mode, so they get their own.
+    for (size_t target = static_cast<size_t>(ParameterInfo::Target::OscA);
+         target < static_cast<size_t>(ParameterInfo::Target::LFO1); target++) {
+        DrawParameterSection(static_cast<ParameterInfo::Target>(target));
+    }
 
-    DrawLFOControls();
+    DrawLFOControls(ParameterInfo::Target::LFO1, ParameterInfo::LFO1_PARAMETERS);
+    DrawLFOControls(ParameterInfo::Target::LFO2, ParameterInfo::LFO2_PARAMETERS);
 
     float framerate = m_io->Framerate;
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / framerate, framerate);
@@ -326,7 +261,7 @@ void GUIManager::DrawPresetControls() {
     if (ImGuiFileDialog::Instance()->Display("SavePresetDlg")) {
         if (ImGuiFileDialog::Instance()->IsOk()) {
             std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
-            if (AudioPresetIO::SaveToFile(*m_preset, filePath))
+            if (AudioPresetIO::SaveToFile(m_preset, filePath))
                 ImGui::OpenPopup("SaveSuccess");
             else
                 ImGui::OpenPopup("SaveFail");
@@ -356,10 +291,12 @@ void GUIManager::DrawPresetControls() {
     if (ImGuiFileDialog::Instance()->Display("LoadPresetDlg")) {
         if (ImGuiFileDialog::Instance()->IsOk()) {
             std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
-            if (AudioPresetIO::LoadFromFile(*m_preset, filePath))
+            if (AudioPresetIO::LoadFromFile(m_preset, filePath)) {
+                PublishPresetSwitch();
                 ImGui::OpenPopup("LoadSuccess");
-            else
+            }else {
                 ImGui::OpenPopup("LoadFail");
+            }
         }
         ImGuiFileDialog::Instance()->Close();
     }
@@ -397,7 +334,8 @@ void GUIManager::DrawPresetControls() {
                 currentPresetIndex = i;
 
                 // Load the selected preset
-                loader.LoadBuiltInPreset(*m_preset, presetNames[i]);
+                loader.LoadBuiltInPreset(m_preset, presetNames[i]);
+                PublishPresetSwitch();
 
                 ImGui::OpenPopup("PresetLoadedPopup");
             }
@@ -416,91 +354,57 @@ void GUIManager::DrawPresetControls() {
     }
 }
 
-void GUIManager::DrawLFOControls() {
-    ImGui::SeparatorText("LFO 1");
-
-    bool LFO1OnTemp = m_preset->synthLFO1On.load();
-    ImGui::Checkbox("On##LFO1", &LFO1OnTemp);
-    m_preset->synthLFO1On.store(LFO1OnTemp);
-
-    // --- LFO 1 mode drop down --- 
-    LFOConfig::Mode lfo1ModeTemp = m_preset->synthLFO1Mode.load();
+void GUIManager::DrawParameterSection(ParameterInfo::Target target) {
+    ImGui::SeparatorText(ParameterInfo::TargetNames[static_cast<size_t>(target)]);
 
-    if (ImGui::BeginCombo("Mode##LFO1", LFOConfig::ModeNames[static_cast<int>(lfo1ModeTemp)])) {
-        for (size_t n = 0; n < IM_ARRAYSIZE(LFOConfig::ModeNames); n++) {
-            bool isSelected = (static_cast<size_t>(lfo1ModeTemp) == n);
-            if (ImGui::Selectable(LFOConfig::ModeNames[n], isSelected)) {
-                lfo1ModeTemp = static_cast<LFOConfig::Mode>(n);
-            }
-            if (isSelected) {
-                ImGui::SetItemDefaultFocus();
-            }
+    // Several sections have widgets with the same label
+    ImGui::PushID(static_cast<int>(target));
+    for (const ParameterSpec& spec : PARAMETER_SPECS) {
+        if (spec.target == target) {
+            DrawParameter(spec.id);
         }
-        ImGui::EndCombo();
     }
-    m_preset->synthLFO1Mode.store(lfo1ModeTemp);
+    ImGui::PopID();
+}
 
-    // --- LFO 1 destination drop down --- 
-    LFOConfig::Destination lfo1DestinationTemp = m_preset->synthLFO1Destination.load();
-    std::vector<std::string> destinationNames = LFOConfig::GetDestinationNames();
+void GUIManager::DrawParameter(ParameterInfo::ID id) {
+    const ParameterSpec& spec = ParameterInfo::GetSpec(id);
+    DrawParameter(id, spec.minValue, spec.maxValue, spec.format, spec.isLogarithmic);
+}
 
-    if (ImGui::BeginCombo("Destination##LFO1", destinationNames[static_cast<int>(lfo1DestinationTemp)].c_str())) {
-        for (size_t n = 0; n < LFOConfig::DESTINATION_INFOS.size(); n++) {
-            bool isSelected = (static_cast<size_t>(lfo1DestinationTemp) == n);
-            if (ImGui::Selectable(destinationNames[n].c_str(), isSelected)) {
-                lfo1DestinationTemp = static_cast<LFOConfig::Destination>(n);
-            }
-            if (isSelected) {
-                ImGui::SetItemDefaultFocus();
+void GUIManager::DrawParameter(ParameterInfo::ID id, float minValue, float maxValue, const char *format, bool isLogarithmic) {
+    const ParameterSpec& spec = ParameterInfo::GetSpec(id);
+    float& value = m_preset[id];
+
+    switch (spec.kind) {
+        case ParameterInfo::Kind::Float: {
+            ImGuiSliderFlags flags = isLogarithmic ? ImGuiSliderFlags_Logarithmic : ImGuiSliderFlags_None;
+            ImGui::SliderFloat(spec.label, &value, minValue, maxValue, format, flags);
+            break;
+        }
+        case ParameterInfo::Kind::Int: {
+            int intValue = m_preset.GetInt(id);
+            if (ImGui::SliderInt(spec.label, &intValue, static_cast<int>(minValue), static_cast<int>(maxValue))) {
+                value = static_cast<float>(intValue);
             }
+            break;
         }
-        ImGui::EndCombo();
-    }
-    m_preset->synthLFO1Destination.store(lfo1DestinationTemp);
-
-    LFOConfig::DestinationInfo destInfo = LFOConfig::GetDestinationInfo(lfo1DestinationTemp);
-    
-    // Amount slider
-    float lfo1AmountTemp = m_preset->synthLFO1Amount.load();
-    lfo1AmountTemp = std::clamp(lfo1AmountTemp, destInfo.minValue, destInfo.maxValue);
-    ImGuiSliderFlags_ sliderFlags = destInfo.isLogarithmic ? ImGuiSliderFlags_Logarithmic : ImGuiSliderFlags_None;
-    const char *format = destInfo.format.has_value() ? destInfo.format->c_str() : nullptr;
-
-    ImGui::SliderFloat("Amount##LFO1", &lfo1AmountTemp, destInfo.minValue, destInfo.maxValue, format, sliderFlags);
-    m_preset->synthLFO1Amount.store(lfo1AmountTemp);
-
-
-    switch (lfo1ModeTemp) {
-        case LFOConfig::Mode::Envelope: {
-            // --- Attack ---
-            float attack = m_preset->synthLFO1EnvAttack.load();
-            ImGui::SliderFloat("Attack (s)##LFO1", &attack, 0.0f, 2.0f);
-            m_preset->synthLFO1EnvAttack.store(attack);
-
-            // --- Hold ---
-            float hold = m_preset->synthLFO1EnvHold.load();
-            ImGui::SliderFloat("Hold (s)##LFO1", &hold, 0.0f, 2.0f);
-            m_preset->synthLFO1EnvHold.store(hold);
-
-            // --- Decay ---
-            float dec = m_preset->synthLFO1EnvDec.load();
-            ImGui::SliderFloat("Decay (s)##LFO1", &dec, 0.0f, 2.0f);
-            m_preset->synthLFO1EnvDec.store(dec);
-
-            // --- Sustain ---
-            float sus = m_preset->synthLFO1EnvSus.load();
-            ImGui::SliderFloat("Sustain (level)##LFO1", &sus, 0.0f, 1.0f);
-            m_preset->synthLFO1EnvSus.store(sus);
+        case ParameterInfo::Kind::Bool: {
+            bool on = m_preset.GetBool(id);
+            if (ImGui::Checkbox(spec.label, &on)) {
+                value = on ? 1.0f : 0.0f;
+            }
             break;
         }
-        case LFOConfig::Mode::Periodic: {
-            // --- Waveform dropdown ---
-            WaveformInfo::Type waveformLFO1Temp = m_preset->synthLFO1Waveform.load();
-            if (ImGui::BeginCombo("Waveform##LFO1", WaveformInfo::Names[static_cast<int>(waveformLFO1Temp)])) {
-                for (int n = 0; n < IM_ARRAYSIZE(WaveformInfo::Names); n++) {
-                    bool isSelected = (static_cast<int>(waveformLFO1Temp) == n);
-                    if (ImGui::Selectable(WaveformInfo::Names[n], isSelected)) {
-                        waveformLFO1Temp = static_cast<WaveformInfo::Type>(n);
+        case ParameterInfo::Kind::Choice: {
+            int selected = m_preset.GetInt(id);
+            int numChoices = static_cast<int>(maxValue) + 1;
+
+            if (ImGui::BeginCombo(spec.label, spec.choiceNames[selected])) {
+                for (int n = 0; n < numChoices; n++) {
+                    bool isSelected = (selected == n);
+                    if (ImGui::Selectable(spec.choiceNames[n], isSelected)) {
+                        value = static_cast<float>(n);
                     }
                     if (isSelected) {
                         ImGui::SetItemDefaultFocus();
@@ -508,128 +412,43 @@ void GUIManager::DrawLFOControls() {
                 }
                 ImGui::EndCombo();
             }
-            m_preset->synthLFO1Waveform.store(waveformLFO1Temp);
-            // ---
-
-            float freq = m_preset->synthLFO1Frequency.load();
-            ImGui::SliderFloat("Frequency (Hz)##LFO1", &freq, 0.1f, 100.0f);
-            m_preset->synthLFO1Frequency.store(freq);
-            break;
-        }
-        case LFOConfig::Mode::Random: {
-            float freq = m_preset->synthLFO1Frequency.load();
-            ImGui::SliderFloat("Frequency (Hz)##LFO1", &freq, 0.1f, 100.0f);
-            m_preset->synthLFO1Frequency.store(freq);
             break;
         }
     }
+}
 
+void GUIManager::DrawLFOControls(ParameterInfo::Target target, const ParameterInfo::LFOParameterIDs& ids) {
+    ImGui::SeparatorText(ParameterInfo::TargetNames[static_cast<size_t>(target)]);
+    ImGui::PushID(static_cast<int>(target));
 
-    ImGui::SeparatorText("LFO 2");
-
-    bool LFO2OnTemp = m_preset->synthLFO2On.load();
-    ImGui::Checkbox("On##LFO2", &LFO2OnTemp);
-    m_preset->synthLFO2On.store(LFO2OnTemp);
-
-    // --- LFO 2 mode drop down --- 
-    LFOConfig::Mode lfo2ModeTemp = m_preset->synthLFO2Mode.load();
-
-    if (ImGui::BeginCombo("Mode##LFO2", LFOConfig::ModeNames[static_cast<int>(lfo2ModeTemp)])) {
-        for (size_t n = 0; n < IM_ARRAYSIZE(LFOConfig::ModeNames); n++) {
-            bool isSelected = (static_cast<size_t>(lfo2ModeTemp) == n);
-            if (ImGui::Selectable(LFOConfig::ModeNames[n], isSelected)) {
-                lfo2ModeTemp = static_cast<LFOConfig::Mode>(n);
-            }
-            if (isSelected) {
-                ImGui::SetItemDefaultFocus();
-            }
-        }
-        ImGui::EndCombo();
-    }
-    m_preset->synthLFO2Mode.store(lfo2ModeTemp);
-
-    // --- LFO 2 destination drop down --- 
-    LFOConfig::Destination lfo2DestinationTemp = m_preset->synthLFO2Destination.load();
-    destinationNames = LFOConfig::GetDestinationNames();
+    DrawParameter(ids.on);
+    DrawParameter(ids.mode);
+    DrawParameter(ids.destination);
 
-    if (ImGui::BeginCombo("Destination##LFO2", destinationNames[static_cast<int>(lfo2DestinationTemp)].c_str())) {
-        for (size_t n = 0; n < LFOConfig::DESTINATION_INFOS.size(); n++) {
-            bool isSelected = (static_cast<size_t>(lfo2DestinationTemp) == n);
-            if (ImGui::Selectable(destinationNames[n].c_str(), isSelected)) {
-                lfo2DestinationTemp = static_cast<LFOConfig::Destination>(n);
-            }
-            if (isSelected) {
-                ImGui::SetItemDefaultFocus();
-            }
-        }
-        ImGui::EndCombo();
-    }
-    m_preset->synthLFO2Destination.store(lfo2DestinationTemp);
-
-    destInfo = LFOConfig::GetDestinationInfo(lfo2DestinationTemp);
-    
-    // Amount slider
-    float lfo2AmountTemp = m_preset->synthLFO2Amount.load();
-    lfo2AmountTemp = std::clamp(lfo2AmountTemp, destInfo.minValue, destInfo.maxValue);
-    sliderFlags = destInfo.isLogarithmic ? ImGuiSliderFlags_Logarithmic : ImGuiSliderFlags_None;
-    format = destInfo.format.has_value() ? destInfo.format->c_str() : nullptr;
-
-    ImGui::SliderFloat("Amount##LFO2", &lfo2AmountTemp, destInfo.minValue, destInfo.maxValue, format, sliderFlags);
-    m_preset->synthLFO2Amount.store(lfo2AmountTemp);
-
-    switch (lfo2ModeTemp) {
-        case LFOConfig::Mode::Envelope: {
-            // --- Attack ---
-            float attack = m_preset->synthLFO2EnvAttack.load();
-            ImGui::SliderFloat("Attack (s)##LFO2", &attack, 0.0f, 2.0f);
-            m_preset->synthLFO2EnvAttack.store(attack);
-
-            // --- Hold ---
-            float hold = m_preset->synthLFO2EnvHold.load();
-            ImGui::SliderFloat("Hold (s)##LFO2", &hold, 0.0f, 2.0f);
-            m_preset->synthLFO2EnvHold.store(hold);
-
-            // --- Decay ---
-            float dec = m_preset->synthLFO2EnvDec.load();
-            ImGui::SliderFloat("Decay (s)##LFO2", &dec, 0.0f, 2.0f);
-            m_preset->synthLFO2EnvDec.store(dec);
-
-            // --- Sustain ---
-            float sus = m_preset->synthLFO2EnvSus.load();
-            ImGui::SliderFloat("Sustain (level)##LFO2", &sus, 0.0f, 1.0f);
-            m_preset->synthLFO2EnvSus.store(sus);
+    // The range and unit of the amount depend on the destination
+    const LFOConfig::DestinationInfo& destInfo =
+        LFOConfig::GetDestinationInfo(m_preset.GetChoice<LFOConfig::Destination>(ids.destination));
+    m_preset[ids.amount] = std::clamp(m_preset[ids.amount], destInfo.minValue, destInfo.maxValue);
+    const char *format = destInfo.format.has_value() ? destInfo.format->c_str() : nullptr;
+    DrawParameter(ids.amount, destInfo.minValue, destInfo.maxValue, format, destInfo.isLogarithmic);
+
+    switch (m_preset.GetChoice<LFOConfig::Mode>(ids.mode)) {
+        case LFOConfig::Mode::Envelope:
+            DrawParameter(ids.envAttack);
+            DrawParameter(ids.envHold);
+            DrawParameter(ids.envDecay);
+            DrawParameter(ids.envSustain);
             break;
-        }
-        case LFOConfig::Mode::Periodic: {
-            // --- Waveform dropdown ---
-            WaveformInfo::Type waveformLFO2Temp = m_preset->synthLFO2Waveform.load();
-            if (ImGui::BeginCombo("Waveform##LFO2", WaveformInfo::Names[static_cast<int>(waveformLFO2Temp)])) {
-                for (int n = 0; n < IM_ARRAYSIZE(WaveformInfo::Names); n++) {
-                    bool isSelected = (static_cast<int>(waveformLFO2Temp) == n);
-                    if (ImGui::Selectable(WaveformInfo::Names[n], isSelected)) {
-                        waveformLFO2Temp = static_cast<WaveformInfo::Type>(n);
-                    }
-                    if (isSelected) {
-                        ImGui::SetItemDefaultFocus();
-                    }
-                }
-                ImGui::EndCombo();
-            }
-            m_preset->synthLFO2Waveform.store(waveformLFO2Temp);
-            // ---
-
-            float freq = m_preset->synthLFO2Frequency.load();
-            ImGui::SliderFloat("Frequency (Hz)##LFO2", &freq, 0.1f, 100.0f);
-            m_preset->synthLFO2Frequency.store(freq);
+        case LFOConfig::Mode::Periodic:
+            DrawParameter(ids.waveform);
+            DrawParameter(ids.frequency);
             break;
-        }
-        case LFOConfig::Mode::Random: {
-            float freq = m_preset->synthLFO2Frequency.load();
-            ImGui::SliderFloat("Frequency (Hz)##LFO2", &freq, 0.1f, 100.0f);
-            m_preset->synthLFO2Frequency.store(freq);
+        case LFOConfig::Mode::Random:
+            DrawParameter(ids.frequency);
             break;
-        }
     }
+
+    ImGui::PopID();
 }
 
 void GUIManager::glfw_error_callback(int error, const char* description) {
@@ -694,6 +513,11 @@ GLFWwindow *GUIManager::InitAux() {
     style.ScaleAllSizes(main_scale);        // Bake a fixed style scale. (until we have a solution for dynamic style scaling, changing this requires resetting Style + calling this again)
     style.FontScaleDpi = main_scale;        // Set initial font scale. (using io.ConfigDpiScaleFonts=true makes this unnecessary. We leave both here for documentation purpose)
 
+    // Install our callbacks before the ImGui backend, which then forwards the events to them
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, KeyCallback);
+    glfwSetWindowFocusCallback(window, WindowFocusCallback);
+
     // Setup Platform/Renderer backends
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
@@ -730,17 +554,60 @@ void GUIManager::DeinitAux() {
     glfwTerminate();
 }
 
-void GUIManager::HandleKeyboardInput() {
-    m_preset->noteA5.store(glfwGetKey(m_window, GLFW_KEY_Z) == GLFW_PRESS);
-    m_preset->noteAs5.store(glfwGetKey(m_window, GLFW_KEY_S) == GLFW_PRESS);
-    m_preset->noteB5.store(glfwGetKey(m_window, GLFW_KEY_X) == GLFW_PRESS);
-    m_preset->noteC5.store(glfwGetKey(m_window, GLFW_KEY_D) == GLFW_PRESS);
-    m_preset->noteCs5.store(glfwGetKey(m_window, GLFW_KEY_C) == GLFW_PRESS);
-    m_preset->noteD5.store(glfwGetKey(m_window, GLFW_KEY_V) == GLFW_PRESS);
-    m_preset->noteDs5.store(glfwGetKey(m_window, GLFW_KEY_G) == GLFW_PRESS);
-    m_preset->noteE5.store(glfwGetKey(m_window, GLFW_KEY_B) == GLFW_PRESS);
-    m_preset->noteF5.store(glfwGetKey(m_window, GLFW_KEY_H) == GLFW_PRESS);
-    m_preset->noteFs5.store(glfwGetKey(m_window, GLFW_KEY_N) == GLFW_PRESS);
-    m_preset->noteG5.store(glfwGetKey(m_window, GLFW_KEY_J) == GLFW_PRESS);
-    m_preset->noteGs5.store(glfwGetKey(m_window, GLFW_KEY_M) == GLFW_PRESS);
+void GUIManager::KeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
+    (void)scancode;
+    (void)mods;
+    static_cast<GUIManager*>(glfwGetWindowUserPointer(window))->HandleKeyEvent(key, action);
+}
+
+void GUIManager::WindowFocusCallback(GLFWwindow *window, int focused) {
+    if (!focused) {
+        static_cast<GUIManager*>(glfwGetWindowUserPointer(window))->ReleaseAllNotes();
+    }
+}
+
+void GUIManager::HandleKeyEvent(int key, int action) {
+    if (action == GLFW_REPEAT) {
+        return;
+    }
+
+    // Don't play notes while typing into a text field (but always let go of held ones)
+    bool isTyping = ImGui::GetIO().WantTextInput;
+
+    if (action == GLFW_PRESS && !isTyping) {
+        if (key == GLFW_KEY_COMMA) {
+            m_octave = std::max(m_octave - 1, s_minOctave);
+            return;
+        }else if (key == GLFW_KEY_PERIOD) {
+            m_octave = std::min(m_octave + 1, s_maxOctave);
+            return;
+        }
+    }
+
+    auto it = std::find(s_noteKeys.begin(), s_noteKeys.end(), key);
+    if (it == s_noteKeys.end()) {
+        return;
+    }
+    std::optional<Note>& heldNote = m_heldNotes[it - s_noteKeys.begin()];
+
+    if (action == GLFW_PRESS) {
+        if (heldNote || isTyping) {
+            return;
+        }
+        size_t index = it - s_noteKeys.begin();
+        heldNote = Note(static_cast<Key>(index), m_octave);
+        m_events->NoteOnNow(*heldNote, s_keyboardVelocity);
+    }else if (heldNote) {
+        m_events->NoteOffNow(*heldNote);
+        heldNote.reset();
+    }
+}
+
+void GUIManager::ReleaseAllNotes() {
+    for (std::optional<Note>& heldNote : m_heldNotes) {
+        if (heldNote) {
+            m_events->NoteOffNow(*heldNote);
+            heldNote.reset();
+        }
+    }
 }
\ No newline at end of file
@@ -14,47 +14,140 @@
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 
 #include "preset/AudioPreset.hpp"
+#include "preset/PresetPublisher.hpp"
 #include "gui/Spectrogram.hpp"
 #include "fft/FFTComputer.hpp"
 #include "gui/LevelsDisplay.hpp"
+#include "gui/FrameRateSettings.hpp"
+#include "engine/EngineEventQueue.hpp"
+#include "engine/PartRouting.hpp"
 
+#include <array>
+#include <optional>
 #include <memory>
 #include <iostream>
 #include <format>
+#include <string>
+#include <vector>
 
 // RAII class for managing the GLFW window
 class GUIManager {
 public:
-    GUIManager(std::shared_ptr<AudioPreset> preset, std::shared_ptr<FFTComputer> fftComputer);
+    // One preset publisher per part of the engine, routed by the table
+    GUIManager(std::vector<std::shared_ptr<PresetPublisher>> partPresets, std::shared_ptr<PartRoutingTable> routing,
+               std::shared_ptr<FFTComputer> fftComputer, std::shared_ptr<EngineEventQueue> events,
+               FrameRateSettings frameRates = {});
 
     ~GUIManager();
 
     void RunMainLoop();
+
+    // Replaces the preset of every part, and sends them to the audio thread right away
+    void SetPreset(const AudioPreset& preset);
     
     static void glfw_error_callback(int error, const char* description);
     
 private:
     void DrawPresetControlWindow();
 
+    // Which part the preset controls edit, and which notes the part plays
+    void DrawPartControls();
+
+    // Parks the edited preset with its part and starts editing another part's
+    void SelectPart(size_t part);
+
+    // Like "C#4", for a Note::GetIndex()
+    static std::string GetNoteName(int noteIndex);
+
+    // Sends the edited preset to the audio thread, if it changed since last time
+    void PublishPresetChanges();
+
+    // Sends a newly loaded preset to the audio thread, which crossfades to it
+    void PublishPresetSwitch();
+
     // Used in synth UI to display export/load preset buttons
     void DrawPresetControls();
 
+    // A separator and a widget for every parameter of the target
+    void DrawParameterSection(ParameterInfo::Target target);
+
+    // The widget for a parameter, chosen by its kind in the parameter registry
+    void DrawParameter(ParameterInfo::ID id);
+    void DrawParameter(ParameterInfo::ID id, float minValue, float maxValue, const char *format, bool isLogarithmic);
+
     // Used in synth UI display controls related to LFOs
-    void DrawLFOControls();
+    void DrawLFOControls(ParameterInfo::Target target, const ParameterInfo::LFOParameterIDs& ids);
 
     GLFWwindow *InitAux();
     void DeinitAux();
 
-    void HandleKeyboardInput();
+    // GLFW callbacks, called from glfwWaitEvents*() as soon as the events arrive, which
+    // timestamps the notes far more precisely than checking the keys once per frame would
+    static void KeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
+    static void WindowFocusCallback(GLFWwindow *window, int focused);
+
+    void HandleKeyEvent(int key, int action);
+
+    // Releases all held notes, since their key releases won't reach us without focus
+    void ReleaseAllNotes();
 
-    std::shared_ptr<AudioPreset> m_preset;
+    // The computer keyboard key that plays each note, from A upwards
+    static constexpr std::array<int, 12> s_noteKeys = {
+        GLFW_KEY_Z, GLFW_KEY_S, GLFW_KEY_X, GLFW_KEY_D, GLFW_KEY_C, GLFW_KEY_V,
+        GLFW_KEY_G, GLFW_KEY_B, GLFW_KEY_H, GLFW_KEY_N, GLFW_KEY_J, GLFW_KEY_M
+    };
+
+    // The keyboard has no velocity, so play everything at full
+    static constexpr float s_keyboardVelocity = 1.0f;
+
+    // Octave the keys play in, shifted with the comma and period keys. Note goes up to octave 13,
+    // far above Nyquist; the top key of octave 8 (G#) is about 6.6 kHz.
+    static constexpr int s_minOctave = 1;
+    static constexpr int s_maxOctave = 8;
+
+    // Sleeps (while handling events) until the next frame is due
+    void WaitForNextFrame();
+
+    double GetFrameInterval(double now) const;
+
+    // Stay at the full frame rate this long after the last input or sound,
+    // so that hover effects and the level meter hold can settle
+    static constexpr double s_activityHoldTime = 1.0;
+
+    // Output below this (-80 dBFS) counts as silence
+    static constexpr float s_silenceThreshold = 1e-4f;
+
+    // The presets of the parts that aren't being edited
+    struct PartPresets {
+        std::shared_ptr<PresetPublisher> publisher;
+        AudioPreset preset;
+        AudioPreset publishedPreset;
+    };
+    std::vector<PartPresets> m_parts;
+    std::shared_ptr<PartRoutingTable> m_routing;
+    size_t m_selectedPart = 0;
+
+    // The selected part's publisher. The widgets edit this copy of its preset,
+    // and whole snapshots of it are published.
+    std::shared_ptr<PresetPublisher> m_presets;
+    AudioPreset m_preset;
+    AudioPreset m_publishedPreset;
     std::shared_ptr<FFTComputer> m_fftComputer;
+    std::shared_ptr<EngineEventQueue> m_events;
+
+    // The note each key started, which stays the one to release even if the octave changes
+    std::array<std::optional<Note>, s_noteKeys.size()> m_heldNotes {};
+    int m_octave = 5;
 
     GLFWwindow *m_window;
     ImGuiIO *m_io;
     Spectrogram m_spectrogram;
     LevelsDisplay m_levelsDisplay;
 
+    FrameRateSettings m_frameRates;
+    double m_lastFrameTime = 0.0;
+    double m_lastActivityTime = 0.0;
+
     // Background color
     static inline ImVec4 clear_color = ImVec4(17.0 / 255.0, 38.0 / 255.0, 92.0 / 255.0, 0.5f);
 };
\ No newline at end of file
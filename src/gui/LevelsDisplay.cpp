@@ -19,17 +19,23 @@ void LevelsDisplay::SetPixelHelper(std::vector<unsigned char>& pixels, int x, in
     std::memcpy(&pixels[pixelIndex * 3], rgb.data(), 3 * sizeof(unsigned char));
 }
 
-void LevelsDisplay::UpdateLevels(const AudioFrame& levels) {
+double LevelsDisplay::ToNormalizedDB(float linear) {
     // Convert to dB normalized in range [0, 1]
-    double dbL = 20.0 * std::log10(levels.left);
-    double dbR = 20.0 * std::log10(levels.right);
+    double db = 20.0 * std::log10(linear);
     const double minDb = -100.0;
     const double maxDb = 0.0;
-    double normL = std::clamp((dbL - minDb) / (maxDb - minDb), 0.0, 1.0);
-    double normR = std::clamp((dbR - minDb) / (maxDb - minDb), 0.0, 1.0);
+    return std::clamp((db - minDb) / (maxDb - minDb), 0.0, 1.0);
+}
+
+void LevelsDisplay::UpdateLevels(const AudioLevels& levels) {
+    m_levels = levels;
+
+    double normL = ToNormalizedDB(levels.rms.left);
+    double normR = ToNormalizedDB(levels.rms.right);
 
-    m_leftHistory.Add(normL);
-    m_rightHistory.Add(normR);
+    // Hold the true peaks, so short transients the RMS smooths out still show
+    m_leftHistory.Add(ToNormalizedDB(levels.truePeak.left));
+    m_rightHistory.Add(ToNormalizedDB(levels.truePeak.right));
 
     // Init pixels with background colors
     std::vector<unsigned char> pixels(s_texWidth * s_texHeight * 3);
@@ -73,17 +79,30 @@ void LevelsDisplay::UpdateLevels(const AudioFrame& levels) {
         }
     }
 
+    if (pixels == m_uploadedPixels) {
+        // Nothing changed (e.g. silence), so skip the upload
+        return;
+    }
+    m_uploadedPixels = std::move(pixels);
+
     // Upload to OpenGL texture
     glBindTexture(GL_TEXTURE_2D, m_levelsTex);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, s_texWidth, s_texHeight,
-                    GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+                    GL_RGB, GL_UNSIGNED_BYTE, m_uploadedPixels.data());
 }
 
-void LevelsDisplay::Show() {
-    ImGui::Begin("Lvl");
-    ImGui::Image((ImTextureID)(intptr_t)m_levelsTex,
-                 ImVec2(s_UIWidth, s_UIHeight));
+bool LevelsDisplay::Show() {
+    bool visible = ImGui::Begin("Lvl");
+    if (visible) {
+        ImGui::Image((ImTextureID)(intptr_t)m_levelsTex,
+                     ImVec2(s_UIWidth, s_UIHeight));
+        ImGui::Text("M %.1f LUFS", m_levels.momentaryLoudness);
+        ImGui::Text("S %.1f LUFS", m_levels.shortTermLoudness);
+        float truePeak = std::max(m_levels.truePeak.left, m_levels.truePeak.right);
+        ImGui::Text("TP %.1f dB", truePeak > 0.0f ? 20.0f * std::log10(truePeak) : -100.0f);
+    }
     ImGui::End();
+    return visible;
 }
 
 void LevelsDisplay::InitTexture() {
@@ -7,17 +7,19 @@
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 #include "gui/LevelsHistory.hpp"
 #include "engine/AudioBackend.hpp"
+#include "fft/LevelMeter.hpp"
 #include <vector>
 #include <array>
 #include <utility>
 #include <deque>
 
+// Level bars (RMS, with the recent true peak held above them) and loudness readouts
 class LevelsDisplay {
 public:
-    void UpdateLevels(const AudioFrame& levels);
+    void UpdateLevels(const AudioLevels& levels);
 
-    // Render in imgui
-    void Show();
+    // Render in imgui. Returns false if the window is collapsed or hidden
+    bool Show();
     
     // Create texture once. Must be done after GL context has been initialized
     void InitTexture();
@@ -37,8 +39,14 @@ private:
     static const std::array<unsigned char, 3> s_secondaryColor;
     static const std::array<unsigned char, 3> s_highlightColor;
 
+    static double ToNormalizedDB(float linear);
+
     LevelsHistory m_leftHistory;
     LevelsHistory m_rightHistory;
 
+    AudioLevels m_levels;
+
+    std::vector<unsigned char> m_uploadedPixels; // Current texture contents
+
     GLuint m_levelsTex = 0;
 };
\ No newline at end of file
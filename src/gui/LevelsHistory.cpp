@@ -6,11 +6,20 @@
 #include <algorithm>
 
 void LevelsHistory::Add(float db) {
-    m_history.push_back(db);
-    if (m_history.size() > s_historySize) {
-        m_history.pop_front();
+    // Drop the oldest level once it slides out of the window
+    if (m_count > 0 && At(0).index + s_historySize <= m_numAdded) {
+        m_front = (m_front + 1) % s_historySize;
+        m_count--;
     }
 
+    // Levels that aren't louder than the new one can never be the max again
+    while (m_count > 0 && At(m_count - 1).value <= db) {
+        m_count--;
+    }
+    At(m_count) = { m_numAdded, db };
+    m_count++;
+    m_numAdded++;
+
     float currentMax = GetMax();
     m_maxWithDecay -= s_decay;
     m_maxWithDecay = std::max(m_maxWithDecay, 0.0f);
@@ -24,10 +33,13 @@ float LevelsHistory::GetMaxWithDecay() {
 }
 
 float LevelsHistory::GetMax() {
-    auto maxIt = std::max_element(m_history.begin(), m_history.end());
-    if (maxIt == m_history.end()) {
+    if (m_count == 0) {
         return 0.0f;
     }
 
-    return *maxIt;
-}
\ No newline at end of file
+    return At(0).value;
+}
+
+LevelsHistory::Entry& LevelsHistory::At(size_t position) {
+    return m_queue[(m_front + position) % s_historySize];
+}
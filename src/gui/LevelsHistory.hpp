@@ -3,8 +3,13 @@
 
 #pragma once
 
-#include <deque>
+#include <array>
+#include <cstddef>
 
+// Keeps track of the loudest of the last few levels, as a peak hold that decays over time.
+// The maximum over the sliding window is kept up to date with a monotonic queue: levels that can
+// never become the maximum again (an older one below a newer one) are dropped right away, so every
+// update is amortized O(1) and the front of the queue is always the current maximum.
 class LevelsHistory {
 public:
     void Add(float db);
@@ -13,11 +18,24 @@ public:
     float GetMaxWithDecay();
 
 private:
+    static constexpr size_t s_historySize = 30;
+
+    struct Entry {
+        size_t index; // Position in the stream of added levels
+        float value;
+    };
+
     float GetMax();
 
+    Entry& At(size_t position);
+
     float m_maxWithDecay = 0.0;
-    std::deque<float> m_history;
+
+    // Ring of decreasing levels, oldest at m_front. Can never hold more than the window size.
+    std::array<Entry, s_historySize> m_queue;
+    size_t m_front = 0;
+    size_t m_count = 0;
+    size_t m_numAdded = 0;
 
     float s_decay = 0.02;
-    size_t s_historySize = 30;
 };
@@ -2,53 +2,41 @@
 // Copyright (c) 2025 Ludvig Sandh
 
 #include "gui/Spectrogram.hpp"
+#include "fft/SpectrogramColumnBuilder.hpp"
 
 #include <cmath>
 #include <algorithm>
 
 // update per audio block
-void Spectrogram::PushColumn(const std::vector<float>& magnitudes) {
-    // Detect size change and reallocate magnitude history if needed
-    if (m_specHeight != (int)magnitudes.size()) {
-        m_specHeight = (int)magnitudes.size();
-        // Reallocate magnitude history buffer
-        m_magnitudeHistory.assign(m_specWidth, std::vector<float>(m_specHeight, 0.0f));
+void Spectrogram::PushColumn(const std::vector<unsigned char>& pixels) {
+    // Detect size change and reallocate the texture if needed
+    if (m_specHeight != (int)pixels.size() / 3) {
+        m_specHeight = (int)pixels.size() / 3;
         ReallocateTexture();
     }
 
-    // Store new magnitudes into the current column
-    m_magnitudeHistory[m_currentColumn] = magnitudes;
-    m_currentColumn = (m_currentColumn + 1) % m_specWidth;
-
-    // Prepare pixels
-    std::vector<unsigned char> pixels(m_specHeight * m_specHeight * 3, 0);
-    for (int column_idx = 0; column_idx < m_specWidth; column_idx++) {
-        int x = (m_currentColumn + column_idx) % m_specWidth;
-        for (int y = 0; y < m_specHeight; y++) {
-            float mag = std::clamp(m_magnitudeHistory[x][y], 0.0f, 1.0f);
-            unsigned char r, g, b;
-            Spectrogram::MagnitudeToRGB(mag, r, g, b);
-
-            int pixel_idx = ((m_specHeight - y - 1) * m_specWidth + column_idx) * 3;
-            pixels[pixel_idx + 0] = r;
-            pixels[pixel_idx + 1] = g;
-            pixels[pixel_idx + 2] = b;
-        }
-    }
-
-    // Upload to OpenGL texture
+    // Upload just that column to the texture
     glBindTexture(GL_TEXTURE_2D, m_spectrogramTex);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_specWidth, m_specHeight,
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, m_currentColumn, 0, 1, m_specHeight,
                     GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    m_currentColumn = (m_currentColumn + 1) % m_specWidth;
 }
 
-void Spectrogram::Show() {
-    if (m_specHeight == 0) return;
+bool Spectrogram::Show() {
+    bool visible = ImGui::Begin("Spectrogram");
+    if (visible && m_specHeight != 0) {
+        // Start drawing at the oldest column. The texture repeats horizontally,
+        // so the newest columns at the start of the texture wrap around to the right edge.
+        float uOffset = static_cast<float>(m_currentColumn) / static_cast<float>(m_specWidth);
 
-    ImGui::Begin("Spectrogram");
-    ImGui::Image((ImTextureID)(intptr_t)m_spectrogramTex,
-                 ImVec2(UI_SPEC_WIDTH, UI_SPEC_HEIGHT));
+        ImGui::Image((ImTextureID)(intptr_t)m_spectrogramTex,
+                     ImVec2(UI_SPEC_WIDTH, UI_SPEC_HEIGHT),
+                     ImVec2(uOffset, 0.0f), ImVec2(uOffset + 1.0f, 1.0f));
+    }
     ImGui::End();
+    return visible;
 }
 
 void Spectrogram::InitTexture() {
@@ -60,49 +48,21 @@ void Spectrogram::ReallocateTexture() {
         glDeleteTextures(1, &m_spectrogramTex);
     }
 
+    // Start out from silence
+    m_currentColumn = 0;
+    const SpectrogramColumnBuilder::Colour& silence = SpectrogramColumnBuilder::GetPalette()[0];
+    std::vector<unsigned char> silentPixels(m_specWidth * m_specHeight * 3);
+    for (size_t i = 0; i < silentPixels.size(); i += 3) {
+        std::copy(silence.begin(), silence.end(), silentPixels.begin() + i);
+    }
+
     glGenTextures(1, &m_spectrogramTex);
     glBindTexture(GL_TEXTURE_2D, m_spectrogramTex);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
                  m_specWidth, m_specHeight, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+                 GL_RGB, GL_UNSIGNED_BYTE, silentPixels.empty() ? nullptr : silentPixels.data());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-}
-
-void Spectrogram::MagnitudeToRGB(float mag, unsigned char& r, unsigned char& g, unsigned char& b)
-{
-    mag *= 2;
-    mag = std::clamp(mag, 0.0f, 1.0f);
-
-    // Define 3 anchor colors (in linear RGB)
-    const float c0[3] = { 0x05 / 255.0f, 0x09 / 255.0f, 0x13 / 255.0f }; // very dark
-    const float c1[3] = { 0x11 / 255.0f, 0x26 / 255.0f, 0x5C / 255.0f }; // base (#11265C)
-    const float c2[3] = { 0x6B / 255.0f, 0xC9 / 255.0f, 0xFF / 255.0f }; // highlight
-
-    float r_f, g_f, b_f;
-
-    if (mag < 0.5f) {
-        // interpolate c0 → c1
-        float t = mag / 0.5f;
-        r_f = (1 - t) * c0[0] + t * c1[0];
-        g_f = (1 - t) * c0[1] + t * c1[1];
-        b_f = (1 - t) * c0[2] + t * c1[2];
-    } else {
-        // interpolate c1 → c2
-        float t = (mag - 0.5f) / 0.5f;
-        r_f = (1 - t) * c1[0] + t * c2[0];
-        g_f = (1 - t) * c1[1] + t * c2[1];
-        b_f = (1 - t) * c1[2] + t * c2[2];
-    }
-
-    // // Optional: apply slight brightness curve to enhance contrast
-    // float gamma = 0.8f; // lower = more contrast
-    // r_f = std::pow(r_f, gamma);
-    // g_f = std::pow(g_f, gamma);
-    // b_f = std::pow(b_f, gamma);
-
-    r = (unsigned char)(std::clamp(r_f, 0.0f, 1.0f) * 255);
-    g = (unsigned char)(std::clamp(g_f, 0.0f, 1.0f) * 255);
-    b = (unsigned char)(std::clamp(b_f, 0.0f, 1.0f) * 255);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT); // Lets the UV offset scroll the ring
 }
@@ -7,13 +7,17 @@
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 #include <vector>
 
+// Scrolling spectrogram. The texture is used as a ring of columns: each new column
+// overwrites the oldest one, and the scrolling is done by offsetting the texture
+// coordinates when drawing, so only one column is uploaded per update.
+// The columns arrive colour mapped from the FFT thread (see SpectrogramColumnBuilder).
 class Spectrogram {
 public:
-    // update per audio block
-    void PushColumn(const std::vector<float>& magnitudes);
+    // update per audio block. Takes RGB pixels, highest frequency first
+    void PushColumn(const std::vector<unsigned char>& pixels);
 
-    // render in imgui
-    void Show();
+    // render in imgui. Returns false if the window is collapsed or hidden
+    bool Show();
 
     // create texture once. Must be done after GL context has been initialized
     void InitTexture();
@@ -21,15 +25,12 @@ public:
     void ReallocateTexture();
 
 private:
-    static void MagnitudeToRGB(float mag, unsigned char& r, unsigned char& g, unsigned char& b);
-
     // Dimensions of spectrogram UI element
     static const int UI_SPEC_HEIGHT = 256;
     static const int UI_SPEC_WIDTH = 512;
 
     GLuint m_spectrogramTex = 0;
-    int m_currentColumn = 0;
-    int m_specHeight = 0; // dynamically set from magnitudes.size()
+    int m_currentColumn = 0; // Column to overwrite next, which holds the oldest data
+    int m_specHeight = 0; // dynamically set from the column size
     const int m_specWidth = 256; // number of time slices visible
-    std::vector<std::vector<float>> m_magnitudeHistory;
-};
\ No newline at end of file
+};
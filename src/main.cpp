@@ -3,9 +3,24 @@
 
 #include "MainApplication.hpp"
 
-int main(int, char**)
+int main(int argc, char** argv)
 {
-    MainApplication app;
+    AppSettings settings;
+    if (!AppSettingsIO::Load(argc, argv, settings)) {
+        return 1;
+    }
+
+    if (settings.listDevices) {
+        ScopedPaHandler paInit;
+        if (paInit.result() != paNoError) {
+            std::cerr << "Couldn't initialise PortAudio: " << Pa_GetErrorText(paInit.result()) << std::endl;
+            return 1;
+        }
+        AudioBackend::PrintOutputDevices();
+        return 0;
+    }
+
+    MainApplication app(settings);
     app.Start();
     return 0;
 }
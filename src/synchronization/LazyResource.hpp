@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include "synchronization/ResourceHandoff.hpp"
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+// Keeps a resource of a requested size available to the audio thread. The resource is allocated on a
+// non-real-time thread once the audio thread asks for it, and freed once it no longer does, so idle
+// effects don't hold on to memory and the audio thread never allocates.
+// T must be constructible from a size_t and provide GetSize() and GetSizeInBytes().
+template <typename T>
+class LazyResource {
+public:
+    // Audio thread, once per buffer: requests a resource of the given size (0 = none).
+    // Returns the resource the audio thread may currently use, which is nullptr until one has been
+    // allocated, and may briefly have a different size than requested while a replacement is prepared.
+    T* Sync(size_t requiredSize) noexcept;
+
+    // Non-real-time thread: allocates, replaces or frees the resource to match the latest request
+    void Manage();
+
+    // Total size of the resources currently allocated, including pending offers. Safe from any thread.
+    size_t GetAllocatedBytes() const;
+
+private:
+    void Free(std::unique_ptr<T> resource);
+
+    std::unique_ptr<T> m_current; // Audio thread only
+    ResourceHandoff<T> m_handoff;
+
+    std::atomic<size_t> m_requiredSize = 0;
+    std::atomic<size_t> m_currentSize = 0;
+    std::atomic<size_t> m_allocatedBytes = 0;
+};
+
+template <typename T>
+T* LazyResource<T>::Sync(size_t requiredSize) noexcept {
+    m_requiredSize.store(requiredSize, std::memory_order_relaxed);
+
+    if (requiredSize == 0) {
+        m_handoff.TryRetire(m_current);
+    }else {
+        m_handoff.TryAdopt(m_current);
+    }
+
+    m_currentSize.store(m_current ? m_current->GetSize() : 0, std::memory_order_relaxed);
+    return m_current.get();
+}
+
+template <typename T>
+void LazyResource<T>::Manage() {
+    Free(m_handoff.CollectRetired());
+
+    size_t required = m_requiredSize.load(std::memory_order_relaxed);
+    if (required == 0 || required == m_currentSize.load(std::memory_order_relaxed)) {
+        // Nothing (more) to prepare
+        Free(m_handoff.Withdraw());
+        return;
+    }
+
+    const T *pending = m_handoff.PeekOffer();
+    if (pending && pending->GetSize() == required) {
+        return; // Already offered, waiting for the audio thread to adopt it
+    }
+
+    auto resource = std::make_unique<T>(required);
+    m_allocatedBytes.fetch_add(resource->GetSizeInBytes(), std::memory_order_relaxed);
+    Free(m_handoff.Offer(std::move(resource)));
+}
+
+template <typename T>
+size_t LazyResource<T>::GetAllocatedBytes() const {
+    return m_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void LazyResource<T>::Free(std::unique_ptr<T> resource) {
+    if (resource) {
+        m_allocatedBytes.fetch_sub(resource->GetSizeInBytes(), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+// Passes heap-allocated resources between a non-real-time thread and the audio thread,
+// so that the audio thread can start and stop using memory without ever allocating or freeing it.
+// The non-real-time side allocates and offers a resource, the audio side adopts it and later
+// hands it back, and the non-real-time side finally frees it.
+// There must be exactly one thread on each side.
+template <typename T>
+class ResourceHandoff {
+public:
+    ResourceHandoff() = default;
+    ResourceHandoff(const ResourceHandoff&) = delete;
+    ResourceHandoff& operator=(const ResourceHandoff&) = delete;
+    ~ResourceHandoff();
+
+    // --- Non-real-time side ---
+
+    // Offers a resource to the audio thread. Returns a previous offer that was never adopted, if any.
+    std::unique_ptr<T> Offer(std::unique_ptr<T> resource);
+
+    // Takes back an offer that hasn't been adopted yet, if any
+    std::unique_ptr<T> Withdraw();
+
+    // Takes ownership of a resource the audio thread has handed back, if any
+    std::unique_ptr<T> CollectRetired();
+
+    // Returns the pending offer without taking it back. Safe because only this side frees offers,
+    // but the audio thread may adopt it at any moment, so treat it as read-only.
+    const T* PeekOffer() const;
+
+    // --- Real-time side (never allocates or frees) ---
+
+    // Replaces `current` with an offered resource, handing the previous one back.
+    // Returns false if nothing was offered, or if the previous hand-back hasn't been collected yet.
+    bool TryAdopt(std::unique_ptr<T>& current) noexcept;
+
+    // Hands `current` back to the non-real-time side, leaving it empty.
+    // Returns false if the previous hand-back hasn't been collected yet.
+    bool TryRetire(std::unique_ptr<T>& current) noexcept;
+
+private:
+    std::atomic<T*> m_offered = nullptr;
+    std::atomic<T*> m_retired = nullptr;
+};
+
+template <typename T>
+ResourceHandoff<T>::~ResourceHandoff() {
+    delete m_offered.exchange(nullptr);
+    delete m_retired.exchange(nullptr);
+}
+
+template <typename T>
+std::unique_ptr<T> ResourceHandoff<T>::Offer(std::unique_ptr<T> resource) {
+    return std::unique_ptr<T>(m_offered.exchange(resource.release(), std::memory_order_acq_rel));
+}
+
+template <typename T>
+std::unique_ptr<T> ResourceHandoff<T>::Withdraw() {
+    return std::unique_ptr<T>(m_offered.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+template <typename T>
+std::unique_ptr<T> ResourceHandoff<T>::CollectRetired() {
+    return std::unique_ptr<T>(m_retired.exchange(nullptr, std::memory_order_acquire));
+}
+
+template <typename T>
+const T* ResourceHandoff<T>::PeekOffer() const {
+    return m_offered.load(std::memory_order_acquire);
+}
+
+template <typename T>
+bool ResourceHandoff<T>::TryAdopt(std::unique_ptr<T>& current) noexcept {
+    if (m_offered.load(std::memory_order_relaxed) == nullptr) {
+        return false;
+    }
+    if (current && m_retired.load(std::memory_order_acquire) != nullptr) {
+        return false; // Nowhere to put the old resource yet, try again later
+    }
+
+    T *incoming = m_offered.exchange(nullptr, std::memory_order_acq_rel);
+    if (incoming == nullptr) {
+        return false; // Withdrawn in the meantime
+    }
+
+    T *previous = current.release();
+    current.reset(incoming);
+    if (previous) {
+        m_retired.store(previous, std::memory_order_release);
+    }
+    return true;
+}
+
+template <typename T>
+bool ResourceHandoff<T>::TryRetire(std::unique_ptr<T>& current) noexcept {
+    if (!current) {
+        return true;
+    }
+    if (m_retired.load(std::memory_order_acquire) != nullptr) {
+        return false;
+    }
+    m_retired.store(current.release(), std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Bounded lock-free queue from exactly one writer thread to exactly one reader thread.
+// Both sides only ever copy items and update their own index, so neither waits, locks or
+// allocates, which makes the writer side safe to call from the audio callback.
+// When the queue is full the writer drops what doesn't fit rather than waiting for the reader.
+template <typename T>
+class SPSCRingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "Items are copied in and out as plain memory.");
+
+public:
+    // The capacity is rounded up to a power of two
+    explicit SPSCRingBuffer(size_t capacity);
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    size_t GetCapacity() const noexcept;
+
+    // --- Writer side ---
+
+    // Appends as many of the items as there is room for. Returns how many were appended.
+    size_t Write(const T *items, size_t count) noexcept;
+
+    // Appends a single item. Returns false if the queue is full.
+    bool Push(const T& item) noexcept;
+
+    // --- Reader side ---
+
+    // Removes up to maxCount of the oldest items into `items`. Returns how many were read.
+    size_t Read(T *items, size_t maxCount) noexcept;
+
+    // Removes the oldest item into `item`. Returns false if the queue is empty.
+    bool Pop(T& item) noexcept;
+
+    // Removes everything written so far without reading it
+    void Discard() noexcept;
+
+    size_t GetNumReadable() const noexcept;
+
+private:
+    std::vector<T> m_items;
+    size_t m_mask;
+
+    // The indices count items ever written and read, and are only masked when indexing.
+    // Each side owns one index and keeps a cached copy of the other, so it only has to touch
+    // the other side's cache line when the cached copy says the queue looks full (or empty).
+    alignas(64) std::atomic<size_t> m_writeIndex = 0;
+    size_t m_cachedReadIndex = 0; // Only touched by the writer
+
+    alignas(64) std::atomic<size_t> m_readIndex = 0;
+    size_t m_cachedWriteIndex = 0; // Only touched by the reader
+};
+
+template <typename T>
+SPSCRingBuffer<T>::SPSCRingBuffer(size_t capacity)
+    : m_items(std::bit_ceil(std::max<size_t>(capacity, 1)))
+    , m_mask(m_items.size() - 1)
+{}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::GetCapacity() const noexcept {
+    return m_items.size();
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::Write(const T *items, size_t count) noexcept {
+    size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    if (writeIndex - m_cachedReadIndex + count > m_items.size()) {
+        m_cachedReadIndex = m_readIndex.load(std::memory_order_acquire);
+    }
+    count = std::min(count, m_items.size() - (writeIndex - m_cachedReadIndex));
+
+    // Copy in at most two runs, split where the ring wraps
+    size_t start = writeIndex & m_mask;
+    size_t firstRun = std::min(count, m_items.size() - start);
+    std::copy(items, items + firstRun, m_items.data() + start);
+    std::copy(items + firstRun, items + count, m_items.data());
+
+    m_writeIndex.store(writeIndex + count, std::memory_order_release);
+    return count;
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::Push(const T& item) noexcept {
+    return Write(&item, 1) == 1;
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::Read(T *items, size_t maxCount) noexcept {
+    size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+    if (m_cachedWriteIndex - readIndex < maxCount) {
+        m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+    }
+    size_t count = std::min(maxCount, m_cachedWriteIndex - readIndex);
+
+    size_t start = readIndex & m_mask;
+    size_t firstRun = std::min(count, m_items.size() - start);
+    std::copy(m_items.data() + start, m_items.data() + start + firstRun, items);
+    std::copy(m_items.data(), m_items.data() + (count - firstRun), items + firstRun);
+
+    m_readIndex.store(readIndex + count, std::memory_order_release);
+    return count;
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::Pop(T& item) noexcept {
+    return Read(&item, 1) == 1;
+}
+
+template <typename T>
+void SPSCRingBuffer<T>::Discard() noexcept {
+    m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+    m_readIndex.store(m_cachedWriteIndex, std::memory_order_release);
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::GetNumReadable() const noexcept {
+    return m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_relaxed);
+}
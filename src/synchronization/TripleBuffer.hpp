@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Publishes snapshots from one writer thread to one reader thread, wait-free on both sides.
+// There are three copies of the value: the writer fills its own, the reader looks at its own,
+// and the third holds the latest published snapshot. Publishing and fetching just swap a
+// buffer index with the middle one, so neither side ever waits, locks or allocates, and the
+// reader always sees a complete snapshot (the latest one at the time it fetched).
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    // Starts all three copies out as `initial`, e.g. to preallocate containers
+    explicit TripleBuffer(const T& initial);
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- Writer side ---
+
+    // The copy to fill in before publishing. Holds whatever was written two publishes ago.
+    T& GetWriteBuffer() noexcept;
+
+    // Makes the write buffer the latest snapshot
+    void Publish() noexcept;
+
+    // --- Reader side ---
+
+    // Fetches the latest snapshot if one has been published since the last fetch.
+    // Returns whether the read buffer changed.
+    bool Fetch() noexcept;
+
+    // The snapshot from the last successful Fetch()
+    const T& GetReadBuffer() const noexcept;
+
+private:
+    // Flag in m_middle telling whether the middle copy holds an unread snapshot
+    static constexpr uint8_t s_newDataFlag = 0x4;
+    static constexpr uint8_t s_indexMask = 0x3;
+
+    // Each copy on its own cache line, so the two threads don't invalidate each other's
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    std::array<Slot, 3> m_slots;
+    std::atomic<uint8_t> m_middle { 1 };
+    uint8_t m_writeIndex = 0; // Only touched by the writer
+    uint8_t m_readIndex = 2; // Only touched by the reader
+};
+
+template <typename T>
+TripleBuffer<T>::TripleBuffer(const T& initial)
+    : m_slots{ Slot{ initial }, Slot{ initial }, Slot{ initial } }
+{}
+
+template <typename T>
+T& TripleBuffer<T>::GetWriteBuffer() noexcept {
+    return m_slots[m_writeIndex].value;
+}
+
+template <typename T>
+void TripleBuffer<T>::Publish() noexcept {
+    // Release our writes together with the buffer, and acquire the one the reader let go of
+    uint8_t previous = m_middle.exchange(m_writeIndex | s_newDataFlag, std::memory_order_acq_rel);
+    m_writeIndex = previous & s_indexMask;
+}
+
+template <typename T>
+bool TripleBuffer<T>::Fetch() noexcept {
+    if ((m_middle.load(std::memory_order_relaxed) & s_newDataFlag) == 0) {
+        return false;
+    }
+    uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+    m_readIndex = previous & s_indexMask;
+    return true;
+}
+
+template <typename T>
+const T& TripleBuffer<T>::GetReadBuffer() const noexcept {
+    return m_slots[m_readIndex].value;
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "synchronization/WorkStealingPool.hpp"
+
+#include <cassert>
+
+WorkStealingPool::WorkStealingPool(size_t numWorkers)
+    : m_numThreads(numWorkers + 1)
+    , m_shares(std::make_unique<Share[]>(numWorkers + 1))
+{
+    m_workers.reserve(numWorkers);
+    for (size_t i = 1; i <= numWorkers; i++) {
+        m_workers.emplace_back([this, i]() {
+            WorkerLoop(i);
+        });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    m_stop.store(true, std::memory_order_release);
+    m_batch.fetch_add(1, std::memory_order_release);
+    m_batch.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+size_t WorkStealingPool::GetNumThreads() const noexcept {
+    return m_numThreads;
+}
+
+std::thread::native_handle_type WorkStealingPool::GetWorkerHandle(size_t worker) {
+    assert(worker < m_workers.size() && "No such worker.");
+    return m_workers[worker].native_handle();
+}
+
+void WorkStealingPool::RunImpl(size_t numTasks, InvokeFunction invoke, void *context) {
+    assert(numTasks <= UINT32_MAX && "Task indices must fit in 32 bits.");
+
+    // Not worth waking anyone for
+    if (m_workers.empty() || numTasks <= 1) {
+        for (size_t i = 0; i < numTasks; i++) {
+            invoke(context, i);
+        }
+        return;
+    }
+
+    m_invoke = invoke;
+    m_context = context;
+    m_remaining.store(numTasks, std::memory_order_relaxed);
+
+    // Contiguous shares, so that a thread without thieves runs its tasks in order
+    for (size_t t = 0; t < m_numThreads; t++) {
+        uint32_t begin = static_cast<uint32_t>(numTasks * t / m_numThreads);
+        uint32_t end = static_cast<uint32_t>(numTasks * (t + 1) / m_numThreads);
+        m_shares[t].range.store(PackRange(begin, end), std::memory_order_release);
+    }
+
+    m_batch.fetch_add(1, std::memory_order_release);
+    m_batch.notify_all();
+
+    Work(0);
+
+    // The last tasks may still be running on other threads
+    while (m_remaining.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void WorkStealingPool::WorkerLoop(size_t self) {
+    uint32_t seenBatch = m_batch.load(std::memory_order_acquire);
+    // The pool may be destroyed before this thread first gets to run. Then the stop was already
+    // bumped into seenBatch.
+    while (!m_stop.load(std::memory_order_acquire)) {
+        m_batch.wait(seenBatch, std::memory_order_acquire);
+        seenBatch = m_batch.load(std::memory_order_acquire);
+        if (m_stop.load(std::memory_order_acquire)) {
+            return;
+        }
+        // Waking up late is harmless: the shares are empty by then, or already hold the next batch
+        Work(self);
+    }
+}
+
+void WorkStealingPool::Work(size_t self) {
+    uint32_t task;
+    while (TakeOwn(self, task) || Steal(self, task)) {
+        m_invoke(m_context, task);
+        m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool WorkStealingPool::TakeOwn(size_t self, uint32_t& task) noexcept {
+    std::atomic<uint64_t>& range = m_shares[self].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t begin = static_cast<uint32_t>(current);
+        uint32_t end = static_cast<uint32_t>(current >> 32);
+        if (begin >= end) {
+            return false;
+        }
+        if (range.compare_exchange_weak(current, PackRange(begin + 1, end), std::memory_order_acq_rel)) {
+            task = begin;
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::Steal(size_t self, uint32_t& task) noexcept {
+    // Start with the next thread over, so thieves spread out over the victims
+    for (size_t offset = 1; offset < m_numThreads; offset++) {
+        std::atomic<uint64_t>& range = m_shares[(self + offset) % m_numThreads].range;
+        uint64_t current = range.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t begin = static_cast<uint32_t>(current);
+            uint32_t end = static_cast<uint32_t>(current >> 32);
+            if (begin >= end) {
+                break;
+            }
+            if (range.compare_exchange_weak(current, PackRange(begin, end - 1), std::memory_order_acq_rel)) {
+                task = end - 1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that, together with the calling thread, run a batch of indexed
+// tasks in parallel. Every thread starts with its own contiguous share of the task indices and,
+// once that's done, steals single tasks from the end of the others' shares. A thread stuck on
+// one slow task therefore never holds up the tasks queued behind it.
+// Run() neither locks nor allocates, so it's safe to call from the audio callback. Only one
+// thread may call Run() at a time.
+class WorkStealingPool {
+public:
+    // Starts numWorkers threads, in addition to the thread that will call Run()
+    explicit WorkStealingPool(size_t numWorkers);
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool();
+
+    // Workers plus the calling thread
+    size_t GetNumThreads() const noexcept;
+
+    // For tuning how the operating system schedules a worker, in [0, GetNumThreads() - 1)
+    std::thread::native_handle_type GetWorkerHandle(size_t worker);
+
+    // Calls task(i) for every i in [0, numTasks) and returns when all calls are done
+    template <typename Task>
+    void Run(size_t numTasks, Task& task) {
+        RunImpl(numTasks, [](void *context, size_t index) {
+            (*static_cast<Task*>(context))(index);
+        }, &task);
+    }
+
+private:
+    using InvokeFunction = void (*)(void *context, size_t index);
+
+    // The task indices [begin, end) a thread has left, packed into one word so that the owner
+    // taking from the front and thieves taking from the back can both use a single CAS.
+    // On separate cache lines, since every thread updates its own all the time.
+    struct alignas(64) Share {
+        std::atomic<uint64_t> range { 0 };
+    };
+
+    static constexpr uint64_t PackRange(uint32_t begin, uint32_t end) noexcept {
+        return (static_cast<uint64_t>(end) << 32) | begin;
+    }
+
+    void RunImpl(size_t numTasks, InvokeFunction invoke, void *context);
+    void WorkerLoop(size_t self);
+
+    // Runs tasks until every share is empty
+    void Work(size_t self);
+    bool TakeOwn(size_t self, uint32_t& task) noexcept;
+    bool Steal(size_t self, uint32_t& task) noexcept;
+
+    size_t m_numThreads;
+    std::unique_ptr<Share[]> m_shares; // Index 0 belongs to the thread calling Run()
+
+    // Set before a batch's shares are filled in, and only read after taking a task from them
+    InvokeFunction m_invoke = nullptr;
+    void *m_context = nullptr;
+
+    std::atomic<size_t> m_remaining { 0 }; // Tasks not finished yet
+    std::atomic<uint32_t> m_batch { 0 };   // Bumped to wake the workers for each batch
+    std::atomic<bool> m_stop { false };
+
+    std::vector<std::thread> m_workers;
+};
@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+// How hard to shield the audio from the rest of the system. All off by default, since each needs
+// permissions that a desktop user usually doesn't have (see ThreadTuning).
+struct RealtimeSettings {
+    bool realtimePriority = false; // SCHED_FIFO for the audio callback and the render workers
+    int priority = 70;             // 1 to 99, lowered to the rtprio limit of unprivileged users
+    bool lockMemory = false;       // Keep all memory in RAM and prefault the audio thread's stack
+    int audioCore = -1;            // Pin the audio callback here and everything else elsewhere, -1 for no pinning
+};
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "system/ThreadTuning.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/resource.h>
+    #if defined(__GLIBC__)
+        #include <malloc.h>
+    #endif
+#endif
+
+namespace {
+    // Far more than the audio callback uses, and far less than a thread's stack
+    constexpr size_t s_prefaultStackBytes = 256 * 1024;
+    constexpr size_t s_pageSize = 4096; // Touching more than once per page is harmless
+}
+
+ThreadTuning::ThreadHandle ThreadTuning::GetCurrentThread() noexcept {
+#if defined(__linux__)
+    return pthread_self();
+#else
+    return ThreadHandle();
+#endif
+}
+
+size_t ThreadTuning::GetNumCores() noexcept {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+ThreadTuning::Result ThreadTuning::SetRealtimePriority(ThreadHandle thread, int priority) noexcept {
+#if defined(__linux__)
+    sched_param param {};
+    param.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    int error = pthread_setschedparam(thread, SCHED_FIFO, &param);
+
+    // Unprivileged users may still go up to their rtprio limit
+    rlimit limit {};
+    if (error == EPERM && getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur > 0
+        && limit.rlim_cur < static_cast<rlim_t>(param.sched_priority)) {
+        param.sched_priority = static_cast<int>(limit.rlim_cur);
+        error = pthread_setschedparam(thread, SCHED_FIFO, &param);
+    }
+    return { error, error == EPERM ? "raise the rtprio limit (ulimit -r), e.g. by joining the audio group" : nullptr };
+#else
+    (void)thread;
+    (void)priority;
+    return { ENOTSUP, nullptr };
+#endif
+}
+
+ThreadTuning::Result ThreadTuning::PinToCore(ThreadHandle thread, int core) noexcept {
+#if defined(__linux__)
+    if (core < 0 || static_cast<size_t>(core) >= GetNumCores()) {
+        return { EINVAL, "there is no such core" };
+    }
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(core, &cores);
+    return { pthread_setaffinity_np(thread, sizeof(cores), &cores), nullptr };
+#else
+    (void)thread;
+    (void)core;
+    return { ENOTSUP, nullptr };
+#endif
+}
+
+ThreadTuning::Result ThreadTuning::PinAwayFromCore(ThreadHandle thread, int core) noexcept {
+#if defined(__linux__)
+    if (GetNumCores() < 2) {
+        return { EINVAL, "there is no other core" };
+    }
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    for (size_t i = 0; i < GetNumCores(); i++) {
+        if (static_cast<int>(i) != core) {
+            CPU_SET(i, &cores);
+        }
+    }
+    return { pthread_setaffinity_np(thread, sizeof(cores), &cores), nullptr };
+#else
+    (void)thread;
+    (void)core;
+    return { ENOTSUP, nullptr };
+#endif
+}
+
+ThreadTuning::Result ThreadTuning::LockMemory() noexcept {
+#if defined(__linux__)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        return { errno, "raise the memlock limit (ulimit -l)" };
+    }
+#if defined(__GLIBC__)
+    // Freed memory stays with the allocator, and large blocks come from the locked heap rather
+    // than from mappings of their own that are unmapped when freed
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    return {};
+#else
+    return { ENOTSUP, nullptr };
+#endif
+}
+
+void ThreadTuning::PrefaultStack() noexcept {
+    unsigned char stack[s_prefaultStackBytes];
+    volatile unsigned char *bytes = stack; // So the writes can't be optimised away
+    for (size_t i = 0; i < s_prefaultStackBytes; i += s_pageSize) {
+        bytes[i] = 0;
+    }
+}
+
+void ThreadTuning::Report(const char *what, const Result& result) {
+    if (result.error == 0) {
+        std::cout << what << ": ok" << std::endl;
+        return;
+    }
+    std::cout << what << ": failed (" << std::strerror(result.error) << ")";
+    if (result.hint != nullptr) {
+        std::cout << ", " << result.hint;
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <cstddef>
+#include <thread>
+
+// Operating system knobs that keep the audio threads from being preempted or stalled by page
+// faults. Only implemented on Linux; elsewhere every call reports ENOTSUP.
+// None of them allocate, so the audio callback can apply them to its own thread. Print the
+// results later with Report().
+namespace ThreadTuning {
+
+using ThreadHandle = std::thread::native_handle_type;
+
+struct Result {
+    int error = 0;              // An errno value, 0 on success
+    const char *hint = nullptr; // What may help if it failed
+};
+
+ThreadHandle GetCurrentThread() noexcept;
+size_t GetNumCores() noexcept;
+
+// SCHED_FIFO at the given priority. Without the privilege to set any priority, it is lowered to
+// the rtprio limit (e.g. from the audio group in /etc/security/limits.d), if there is one.
+Result SetRealtimePriority(ThreadHandle thread, int priority) noexcept;
+
+// Allows the thread to run on the one core only
+Result PinToCore(ThreadHandle thread, int core) noexcept;
+
+// Allows the thread to run on every core but the one
+Result PinAwayFromCore(ThreadHandle thread, int core) noexcept;
+
+// Locks every current and future page of the process into RAM, which also faults them all in,
+// and keeps the allocator from handing freed memory back to the system, which would have to be
+// faulted in again when reused
+Result LockMemory() noexcept;
+
+// Touches the next part of the calling thread's stack, so that it's faulted in (and, with
+// LockMemory(), locked) before it's needed in a hurry
+void PrefaultStack() noexcept;
+
+// Prints "what: ok", or why it failed
+void Report(const char *what, const Result& result);
+
+} // namespace ThreadTuning
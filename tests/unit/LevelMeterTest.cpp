@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+// Checks the K-weighting filter against the coefficients ITU-R BS.1770 lists for 48 kHz.
+// Exits with 1 if any differs.
+
+#include <cmath>
+#include <iostream>
+
+#include "fft/LevelMeter.hpp"
+
+namespace {
+    constexpr double s_tolerance = 1e-7; // The standard gives them to 14 decimals
+
+    bool Check(const char *name, double actual, double expected) {
+        if (std::abs(actual - expected) <= s_tolerance) {
+            return true;
+        }
+        std::cerr << "  " << name << " is " << actual << ", expected " << expected << std::endl;
+        return false;
+    }
+
+    bool Check(const char *stage, const LevelMeter::BiquadCoefficients& actual,
+               const LevelMeter::BiquadCoefficients& expected) {
+        std::cout << stage << std::endl;
+        bool ok = Check("b0", actual.b0, expected.b0);
+        ok &= Check("b1", actual.b1, expected.b1);
+        ok &= Check("b2", actual.b2, expected.b2);
+        ok &= Check("a1", actual.a1, expected.a1);
+        ok &= Check("a2", actual.a2, expected.a2);
+        return ok;
+    }
+}
+
+int main() {
+    std::cout.precision(14);
+    std::cerr.precision(14);
+
+    LevelMeter::KWeighting weighting = LevelMeter::ComputeKWeighting(48000.0f);
+    bool ok = Check("K-weighting shelf at 48 kHz", weighting.shelf,
+                    { 1.53512485958697, -2.69169618940638, 1.19839281085285, -1.69065929318241, 0.73248077421585 });
+    ok &= Check("K-weighting high pass at 48 kHz", weighting.highPass,
+                { 1.0, -2.0, 1.0, -1.99004745483398, 0.99007225036621 });
+
+    std::cout << (ok ? "All coefficients match BS.1770" : "Some coefficients don't match BS.1770") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+// Renders every preset in a folder against the standard note script, spread over all cores,
+// and writes a WAV file per preset plus a JSON report of its levels and render speed.
+//
+// Usage: chirp-batch-render [--presets DIR] [--output DIR] [--jobs N] [--block FRAMES] [--sample-rate HZ]
+//
+// Exits with 1 if any preset failed to load, or if its render was flagged (see the thresholds
+// below), so it can gate a release.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "common/AudioAnalysis.hpp"
+#include "common/OfflineRenderer.hpp"
+#include "common/ParallelFor.hpp"
+#include "common/PresetFiles.hpp"
+#include "common/WavFile.hpp"
+#include "engine/ProcessSpec.hpp"
+#include "preset/AudioPresetSerialization.hpp"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+    // Flag thresholds
+    constexpr double s_maxCpuLoad = 0.25;    // Render time over audio time, on one core
+    constexpr double s_silenceDb = -60.0;    // A peak below this is most likely a broken preset
+
+    struct Options {
+        fs::path presetsFolder = "presets";
+        fs::path outputFolder = "batch_render";
+        size_t numJobs = GetDefaultNumJobs();
+        size_t blockSize = 256;
+        size_t sampleRate = static_cast<size_t>(ProcessSpec::DEFAULT_SAMPLE_RATE);
+    };
+
+    struct PresetResult {
+        fs::path file;
+        bool loaded = false;
+        bool wavWritten = false;
+        LevelAnalysis levels;
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+        std::vector<std::string> flags;
+    };
+
+    bool ParseCount(std::string_view text, size_t& value) {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size() && value > 0;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string_view arg = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string_view value = argv[++i];
+
+            if (arg == "--presets") {
+                options.presetsFolder = value;
+            }else if (arg == "--output") {
+                options.outputFolder = value;
+            }else if (arg == "--jobs") {
+                if (!ParseCount(value, options.numJobs)) {
+                    std::cerr << "Invalid job count: " << value << std::endl;
+                    return false;
+                }
+            }else if (arg == "--block") {
+                if (!ParseCount(value, options.blockSize)) {
+                    std::cerr << "Invalid block size: " << value << std::endl;
+                    return false;
+                }
+            }else if (arg == "--sample-rate") {
+                if (!ParseCount(value, options.sampleRate)) {
+                    std::cerr << "Invalid sample rate: " << value << std::endl;
+                    return false;
+                }
+            }else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void RenderPreset(PresetResult& result, const NoteScript& script, const Options& options) {
+        AudioPreset preset;
+        if (!AudioPresetIO::LoadFromFile(preset, result.file.string())) {
+            result.flags.push_back("failed to load");
+            return;
+        }
+        result.loaded = true;
+
+        RenderResult render = OfflineRenderer::Render(preset, script, options.blockSize, static_cast<float>(options.sampleRate));
+        const int sampleRate = static_cast<int>(options.sampleRate);
+        result.audioSeconds = static_cast<double>(render.frames.size()) / sampleRate;
+        result.renderSeconds = render.renderSeconds;
+        result.levels = AudioAnalysis::Analyze(render.frames, sampleRate);
+
+        fs::path wavPath = options.outputFolder / result.file.stem();
+        wavPath += ".wav";
+        result.wavWritten = WavFile::Write(wavPath, render.frames, sampleRate);
+
+        if (!result.wavWritten) {
+            result.flags.push_back("failed to write WAV");
+        }
+        if (result.levels.numNonFinite > 0) {
+            result.flags.push_back("non-finite samples");
+        }
+        if (result.levels.numClipped > 0) {
+            result.flags.push_back("clipping");
+        }
+        if (result.levels.peakDb < s_silenceDb) {
+            result.flags.push_back("silent");
+        }
+        if (result.renderSeconds > s_maxCpuLoad * result.audioSeconds) {
+            result.flags.push_back("slow");
+        }
+    }
+
+    json ToJson(const PresetResult& result) {
+        json j;
+        j["name"] = result.file.stem().string();
+        j["file"] = result.file.string();
+        j["flags"] = result.flags;
+        if (!result.loaded) {
+            return j;
+        }
+
+        fs::path wavName = result.file.stem();
+        wavName += ".wav";
+        j["wav"] = result.wavWritten ? json(wavName.string()) : json(nullptr);
+
+        j["peakDb"] = result.levels.peakDb;
+        j["rmsDb"] = result.levels.rmsDb;
+        j["loudnessLufs"] = result.levels.loudnessLufs;
+        j["clippedSamples"] = result.levels.numClipped;
+        j["nonFiniteSamples"] = result.levels.numNonFinite;
+
+        j["renderSeconds"] = result.renderSeconds;
+        j["realTimeFactor"] = result.renderSeconds > 0.0 ? result.audioSeconds / result.renderSeconds : 0.0;
+        j["cpuLoad"] = result.audioSeconds > 0.0 ? result.renderSeconds / result.audioSeconds : 0.0;
+        return j;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--presets DIR] [--output DIR] [--jobs N] [--block FRAMES] [--sample-rate HZ]" << std::endl;
+        return 2;
+    }
+
+    std::vector<PresetResult> results;
+    try {
+        for (const fs::path& file : FindPresetFiles(options.presetsFolder)) {
+            PresetResult result;
+            result.file = file;
+            results.push_back(result);
+        }
+        fs::create_directories(options.outputFolder);
+    }catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    if (results.empty()) {
+        std::cerr << "No presets found in " << options.presetsFolder << std::endl;
+        return 2;
+    }
+
+    NoteScript script = OfflineRenderer::GetStandardNoteScript();
+    size_t numJobs = std::min(options.numJobs, results.size());
+    std::cout << "Rendering " << results.size() << " presets with " << numJobs << " jobs" << std::endl;
+
+    // One engine per render, so the workers share nothing but the script
+    std::mutex outputMutex;
+    auto start = std::chrono::steady_clock::now();
+
+    ParallelFor(results.size(), numJobs, [&](size_t i) {
+        PresetResult& result = results[i];
+        try {
+            RenderPreset(result, script, options);
+        }catch (const std::exception& e) {
+            result.flags.push_back(std::string("error: ") + e.what());
+        }
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << "  " << result.file.stem().string();
+        for (const std::string& flag : result.flags) {
+            std::cout << " [" << flag << "]";
+        }
+        std::cout << std::endl;
+    });
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    json report;
+    report["sampleRate"] = options.sampleRate;
+    report["blockSize"] = options.blockSize;
+    report["jobs"] = numJobs;
+    report["scriptSeconds"] = script.duration;
+    report["wallSeconds"] = wallSeconds;
+    report["presets"] = json::array();
+
+    size_t numFlagged = 0;
+    for (const PresetResult& result : results) {
+        report["presets"].push_back(ToJson(result));
+        numFlagged += !result.flags.empty();
+    }
+    report["flagged"] = numFlagged;
+
+    fs::path reportPath = options.outputFolder / "report.json";
+    std::ofstream reportFile(reportPath);
+    reportFile << report.dump(4);
+    if (!reportFile) {
+        std::cerr << "Couldn't write " << reportPath << std::endl;
+        return 2;
+    }
+
+    std::cout << "Rendered " << results.size() << " presets in " << wallSeconds << " s, "
+              << numFlagged << " flagged. Report: " << reportPath.string() << std::endl;
+    return numFlagged > 0 ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+// Renders every preset in a folder against the standard note script, once through the graph of
+// nodes and once through the static chain of the same nodes, and compares their speed and output.
+// Renders run one at a time, alternating between the two, and the fastest of the repeats counts.
+//
+// Usage: chirp-chain-benchmark [--presets DIR] [--repeats N] [--block FRAMES] [--sample-rate HZ]
+//
+// Exits with 1 if any preset failed to load, or if the two renders of any preset differ at all.
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/OfflineRenderer.hpp"
+#include "common/PresetFiles.hpp"
+#include "engine/ProcessSpec.hpp"
+#include "engine/RenderPath.hpp"
+#include "preset/AudioPresetSerialization.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct Options {
+        fs::path presetsFolder = "presets";
+        size_t numRepeats = 3;
+        size_t blockSize = 256;
+        size_t sampleRate = static_cast<size_t>(ProcessSpec::DEFAULT_SAMPLE_RATE);
+    };
+
+    struct Timing {
+        double graphSeconds = 0.0;
+        double chainSeconds = 0.0;
+        float maxDifference = 0.0f;
+    };
+
+    bool ParseCount(std::string_view text, size_t& value) {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size() && value > 0;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string_view arg = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string_view value = argv[++i];
+
+            bool valid = true;
+            if (arg == "--presets") {
+                options.presetsFolder = value;
+            }else if (arg == "--repeats") {
+                valid = ParseCount(value, options.numRepeats);
+            }else if (arg == "--block") {
+                valid = ParseCount(value, options.blockSize);
+            }else if (arg == "--sample-rate") {
+                valid = ParseCount(value, options.sampleRate);
+            }else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+            if (!valid) {
+                std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float GetMaxDifference(const std::vector<AudioFrame>& a, const std::vector<AudioFrame>& b) {
+        if (a.size() != b.size()) {
+            return INFINITY;
+        }
+        float maxDifference = 0.0f;
+        for (size_t i = 0; i < a.size(); i++) {
+            maxDifference = std::max({ maxDifference, std::abs(a[i].left - b[i].left), std::abs(a[i].right - b[i].right) });
+        }
+        return maxDifference;
+    }
+
+    Timing Benchmark(const AudioPreset& preset, const NoteScript& script, const Options& options) {
+        Timing timing { INFINITY, INFINITY, 0.0f };
+        float sampleRate = static_cast<float>(options.sampleRate);
+        for (size_t repeat = 0; repeat < options.numRepeats; repeat++) {
+            RenderResult graph = OfflineRenderer::Render(preset, script, options.blockSize, sampleRate, RenderPath::Graph);
+            RenderResult chain = OfflineRenderer::Render(preset, script, options.blockSize, sampleRate, RenderPath::StaticChain);
+            timing.graphSeconds = std::min(timing.graphSeconds, graph.renderSeconds);
+            timing.chainSeconds = std::min(timing.chainSeconds, chain.renderSeconds);
+            timing.maxDifference = std::max(timing.maxDifference, GetMaxDifference(graph.frames, chain.frames));
+        }
+        return timing;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--presets DIR] [--repeats N] [--block FRAMES] [--sample-rate HZ]" << std::endl;
+        return 2;
+    }
+
+    std::vector<fs::path> files;
+    try {
+        files = FindPresetFiles(options.presetsFolder);
+    }catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    if (files.empty()) {
+        std::cerr << "No presets found in " << options.presetsFolder << std::endl;
+        return 2;
+    }
+
+    NoteScript script = OfflineRenderer::GetStandardNoteScript();
+    std::cout << "Rendering " << files.size() << " presets, best of " << options.numRepeats
+              << ", " << options.blockSize << " frames per block" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    double totalGraphSeconds = 0.0;
+    double totalChainSeconds = 0.0;
+    size_t numFailed = 0;
+    for (const fs::path& file : files) {
+        AudioPreset preset;
+        if (!AudioPresetIO::LoadFromFile(preset, file.string())) {
+            std::cout << "  " << file.stem().string() << " [failed to load]" << std::endl;
+            numFailed++;
+            continue;
+        }
+
+        Timing timing = Benchmark(preset, script, options);
+        totalGraphSeconds += timing.graphSeconds;
+        totalChainSeconds += timing.chainSeconds;
+
+        std::cout << "  " << file.stem().string() << ": graph " << timing.graphSeconds << " s, chain "
+                  << timing.chainSeconds << " s, " << timing.graphSeconds / timing.chainSeconds << "x";
+        if (timing.maxDifference > 0.0f) {
+            std::cout << " [differs by up to " << std::scientific << timing.maxDifference << std::fixed << "]";
+            numFailed++;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Total: graph " << totalGraphSeconds << " s, chain " << totalChainSeconds << " s, "
+              << (totalChainSeconds > 0.0 ? totalGraphSeconds / totalChainSeconds : 0.0) << "x, "
+              << numFailed << " failed" << std::endl;
+    return numFailed > 0 ? 1 : 0;
+}
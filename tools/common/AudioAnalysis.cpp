@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "common/AudioAnalysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+    double ToDb(double amplitude) {
+        return amplitude > 0.0 ? 20.0 * std::log10(amplitude) : AudioAnalysis::SILENCE_DB;
+    }
+
+    // Direct form I, in double precision since the K-weighting shelf sits far below Nyquist
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+        double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+
+        double Process(double x) {
+            double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            return y;
+        }
+    };
+
+    // The two stages of the BS.1770 K-weighting filter. The standard only lists coefficients
+    // for 48 kHz, so they're derived from the analog prototypes for the actual sample rate.
+    Biquad MakeHighShelf(int sampleRate) {
+        double f0 = 1681.974450955533;
+        double gainDb = 3.999843853973347;
+        double q = 0.7071752369554196;
+
+        double k = std::tan(std::numbers::pi * f0 / sampleRate);
+        double vh = std::pow(10.0, gainDb / 20.0);
+        double vb = std::pow(vh, 0.4996667741545416);
+        double a0 = 1.0 + k / q + k * k;
+        return {
+            (vh + vb * k / q + k * k) / a0,
+            2.0 * (k * k - vh) / a0,
+            (vh - vb * k / q + k * k) / a0,
+            2.0 * (k * k - 1.0) / a0,
+            (1.0 - k / q + k * k) / a0
+        };
+    }
+
+    Biquad MakeHighPass(int sampleRate) {
+        double f0 = 38.13547087602444;
+        double q = 0.5003270373238773;
+
+        double k = std::tan(std::numbers::pi * f0 / sampleRate);
+        double a0 = 1.0 + k / q + k * k;
+        return {
+            1.0, -2.0, 1.0,
+            2.0 * (k * k - 1.0) / a0,
+            (1.0 - k / q + k * k) / a0
+        };
+    }
+
+    double MeanSquareToLufs(double meanSquare) {
+        return -0.691 + 10.0 * std::log10(meanSquare);
+    }
+
+    // Gated loudness over 400 ms blocks overlapping by 75%
+    double IntegratedLoudness(const std::vector<double>& weightedPower, int sampleRate) {
+        constexpr double absoluteGate = -70.0;
+        constexpr double relativeGate = -10.0;
+
+        size_t blockLength = static_cast<size_t>(0.4 * sampleRate);
+        size_t hop = blockLength / 4;
+        if (weightedPower.size() < blockLength) {
+            return AudioAnalysis::SILENCE_DB;
+        }
+
+        std::vector<double> blocks;
+        for (size_t start = 0; start + blockLength <= weightedPower.size(); start += hop) {
+            double sum = 0.0;
+            for (size_t i = start; i < start + blockLength; i++) {
+                sum += weightedPower[i];
+            }
+            double meanSquare = sum / blockLength;
+            if (meanSquare > 0.0 && MeanSquareToLufs(meanSquare) > absoluteGate) {
+                blocks.push_back(meanSquare);
+            }
+        }
+        if (blocks.empty()) {
+            return AudioAnalysis::SILENCE_DB;
+        }
+
+        double mean = 0.0;
+        for (double block : blocks) {
+            mean += block;
+        }
+        mean /= blocks.size();
+
+        double threshold = MeanSquareToLufs(mean) + relativeGate;
+        double gatedSum = 0.0;
+        size_t numGated = 0;
+        for (double block : blocks) {
+            if (MeanSquareToLufs(block) > threshold) {
+                gatedSum += block;
+                numGated++;
+            }
+        }
+        return numGated > 0 ? MeanSquareToLufs(gatedSum / numGated) : AudioAnalysis::SILENCE_DB;
+    }
+}
+
+LevelAnalysis AudioAnalysis::Analyze(const std::vector<AudioFrame>& frames, int sampleRate) {
+    LevelAnalysis analysis;
+
+    Biquad shelf[2] = { MakeHighShelf(sampleRate), MakeHighShelf(sampleRate) };
+    Biquad highPass[2] = { MakeHighPass(sampleRate), MakeHighPass(sampleRate) };
+
+    // Sum over the channels of the K-weighted power, per frame
+    std::vector<double> weightedPower;
+    weightedPower.reserve(frames.size());
+
+    double sumOfSquares = 0.0;
+    size_t numSamples = 0;
+    for (const AudioFrame& frame : frames) {
+        double power = 0.0;
+        const float samples[2] = { frame.left, frame.right };
+        for (size_t channel = 0; channel < 2; channel++) {
+            float sample = samples[channel];
+            if (!std::isfinite(sample)) {
+                // Would poison every sum after it, and the filter state
+                analysis.numNonFinite++;
+                sample = 0.0f;
+            }else {
+                analysis.peak = std::max(analysis.peak, std::abs(sample));
+                analysis.numClipped += std::abs(sample) > 1.0f;
+                sumOfSquares += static_cast<double>(sample) * sample;
+                numSamples++;
+            }
+
+            double weighted = highPass[channel].Process(shelf[channel].Process(sample));
+            power += weighted * weighted;
+        }
+        weightedPower.push_back(power);
+    }
+
+    analysis.peakDb = ToDb(analysis.peak);
+    analysis.rmsDb = numSamples > 0 ? ToDb(std::sqrt(sumOfSquares / numSamples)) : SILENCE_DB;
+    analysis.loudnessLufs = IntegratedLoudness(weightedPower, sampleRate);
+    return analysis;
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "engine/AudioFrame.hpp"
+
+struct LevelAnalysis {
+    float peak = 0.0f;         // Largest absolute sample, over both channels
+    double peakDb = 0.0;       // dBFS
+    double rmsDb = 0.0;        // dBFS, over both channels and the whole render
+    double loudnessLufs = 0.0; // Integrated loudness (ITU-R BS.1770), gated
+    size_t numClipped = 0;     // Samples beyond full scale
+    size_t numNonFinite = 0;   // NaN or infinite samples, which are left out of the rest
+};
+
+namespace AudioAnalysis {
+
+// Reported for silence, where the decibel values would be minus infinity
+inline constexpr double SILENCE_DB = -200.0;
+
+LevelAnalysis Analyze(const std::vector<AudioFrame>& frames, int sampleRate);
+
+} // namespace AudioAnalysis
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "common/OfflineRenderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include "engine/AudioEngine.hpp"
+
+namespace {
+    struct ScriptEvent {
+        size_t frame;
+        bool isNoteOn;
+        Note note;
+        float velocity;
+    };
+
+    size_t SecondsToFrames(double seconds, float sampleRate) {
+        return static_cast<size_t>(std::llround(seconds * sampleRate));
+    }
+}
+
+NoteScript OfflineRenderer::GetStandardNoteScript() {
+    NoteScript script;
+
+    // A single note, long enough to reach sustain
+    script.notes.push_back({ Note(Key::A, 5), 1.0f, 0.0, 1.0 });
+
+    // A held chord
+    for (Key key : { Key::C, Key::E, Key::G, Key::B }) {
+        script.notes.push_back({ Note(key, 4), 0.8f, 1.5, 1.5 });
+    }
+
+    // A fast run up an octave
+    const Key run[] = { Key::C, Key::D, Key::E, Key::F, Key::G, Key::A, Key::B };
+    for (size_t i = 0; i < std::size(run); i++) {
+        script.notes.push_back({ Note(run[i], 5), 0.9f, 3.5 + 0.125 * i, 0.1 });
+    }
+    script.notes.push_back({ Note(Key::C, 6), 0.9f, 3.5 + 0.125 * std::size(run), 0.5 });
+
+    // A low note
+    script.notes.push_back({ Note(Key::C, 3), 1.0f, 5.0, 1.0 });
+
+    script.duration = 9.0;
+    return script;
+}
+
+RenderResult OfflineRenderer::Render(const AudioPreset& preset, const NoteScript& script, size_t blockSize, float sampleRate,
+                                      RenderPath renderPath) {
+    // Note offs first when at the same frame, so a repeated note is released before it's played again
+    std::vector<ScriptEvent> events;
+    for (const ScriptedNote& note : script.notes) {
+        events.push_back({ SecondsToFrames(note.start, sampleRate), true, note.note, note.velocity });
+        events.push_back({ SecondsToFrames(note.start + note.length, sampleRate), false, note.note, 0.0f });
+    }
+    std::stable_sort(events.begin(), events.end(), [](const ScriptEvent& a, const ScriptEvent& b) {
+        return a.frame < b.frame || (a.frame == b.frame && !a.isNoteOn && b.isNoteOn);
+    });
+
+    auto presets = std::make_shared<PresetPublisher>();
+    auto fftComputer = std::make_shared<FFTComputer>();
+    auto engineEvents = std::make_shared<EngineEventQueue>();
+    presets->Publish(preset);
+
+    AudioEngine engine(presets, fftComputer, engineEvents);
+    engine.Prepare(sampleRate, blockSize);
+    engine.SetRenderPath(renderPath);
+
+    size_t numFrames = SecondsToFrames(script.duration, sampleRate);
+    RenderResult result;
+    result.sampleRate = sampleRate;
+    result.frames.reserve(numFrames);
+
+    auto start = std::chrono::steady_clock::now();
+    engine.ManageGraphs();
+
+    size_t nextEvent = 0;
+    for (size_t blockStart = 0; blockStart < numFrames; blockStart += blockSize) {
+        size_t blockFrames = std::min(blockSize, numFrames - blockStart);
+
+        // Send the events of this block only, so the queue never fills up however long the script
+        for (; nextEvent < events.size() && events[nextEvent].frame < blockStart + blockFrames; nextEvent++) {
+            const ScriptEvent& event = events[nextEvent];
+            uint32_t offset = static_cast<uint32_t>(event.frame - blockStart);
+            if (event.isNoteOn) {
+                engineEvents->NoteOn(event.note, event.velocity, offset);
+            }else {
+                engineEvents->NoteOff(event.note, offset);
+            }
+        }
+
+        const AudioBuffer& buffer = engine.ProcessBuffer(blockFrames, 0.0);
+        result.frames.insert(result.frames.end(), buffer.outputBuffer.begin(), buffer.outputBuffer.end());
+
+        engine.ManageGraphs();
+    }
+
+    result.renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
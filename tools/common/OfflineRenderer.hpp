@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <vector>
+
+#include "core/Frequency.hpp"
+#include "engine/AudioFrame.hpp"
+#include "engine/ProcessSpec.hpp"
+#include "engine/RenderPath.hpp"
+#include "preset/AudioPreset.hpp"
+
+// A note to play, with its times in seconds from the start of the render
+struct ScriptedNote {
+    Note note;
+    float velocity;
+    double start;
+    double length;
+};
+
+struct NoteScript {
+    std::vector<ScriptedNote> notes;
+    double duration; // Seconds, including time after the last note for tails to ring out
+};
+
+struct RenderResult {
+    std::vector<AudioFrame> frames;
+    float sampleRate = ProcessSpec::DEFAULT_SAMPLE_RATE;
+    double renderSeconds = 0.0; // Wall-clock time spent rendering
+};
+
+namespace OfflineRenderer {
+
+// A single note, a held chord, a fast run and a low note, then a few seconds of silence.
+// Exercises the envelopes, polyphony and the effect tails.
+NoteScript GetStandardNoteScript();
+
+// Plays the script on a fresh engine, without an audio device. The engine renders one block at
+// a time exactly as in the audio callback, with its housekeeping run between blocks.
+// Each call has its own engine, so several can run on different threads at once.
+RenderResult Render(const AudioPreset& preset, const NoteScript& script, size_t blockSize = 256,
+                    float sampleRate = ProcessSpec::DEFAULT_SAMPLE_RATE,
+                    RenderPath renderPath = RenderPath::StaticChain);
+
+} // namespace OfflineRenderer
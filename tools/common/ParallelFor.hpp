@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Calls body(i) for every i in [0, count), spread over numJobs threads. Each thread takes the
+// next index as soon as it's done with the last, so a few slow items don't hold the rest up.
+// body must be safe to call from several threads at once, for different indices.
+template <typename Body>
+void ParallelFor(size_t count, size_t numJobs, Body body) {
+    numJobs = std::clamp<size_t>(numJobs, 1, std::max<size_t>(count, 1));
+
+    std::atomic<size_t> next = 0;
+    std::vector<std::thread> workers;
+    for (size_t job = 0; job < numJobs; job++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                body(i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// All cores, or one if that can't be told
+inline size_t GetDefaultNumJobs() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "common/WavFile.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    constexpr uint16_t s_formatFloat = 3; // WAVE_FORMAT_IEEE_FLOAT
+    constexpr uint16_t s_numChannels = 2;
+    constexpr uint16_t s_bitsPerSample = 32;
+
+    // WAV is little endian, so write byte by byte rather than relying on the host
+    void WriteU16(std::ofstream& file, uint16_t value) {
+        char bytes[2] = { static_cast<char>(value & 0xff), static_cast<char>(value >> 8) };
+        file.write(bytes, sizeof(bytes));
+    }
+
+    void WriteU32(std::ofstream& file, uint32_t value) {
+        WriteU16(file, static_cast<uint16_t>(value & 0xffff));
+        WriteU16(file, static_cast<uint16_t>(value >> 16));
+    }
+
+    uint16_t ReadU16(const unsigned char *bytes) {
+        return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    }
+
+    uint32_t ReadU32(const unsigned char *bytes) {
+        return ReadU16(bytes) | (static_cast<uint32_t>(ReadU16(bytes + 2)) << 16);
+    }
+
+    float ReadFloat(const unsigned char *bytes) {
+        uint32_t bits = ReadU32(bytes);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void WriteFloat(std::ofstream& file, float value) {
+        uint32_t bits;
+        static_assert(sizeof(bits) == sizeof(value));
+        std::memcpy(&bits, &value, sizeof(bits));
+        WriteU32(file, bits);
+    }
+}
+
+bool WavFile::Write(const std::filesystem::path& path, const std::vector<AudioFrame>& frames, int sampleRate) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    uint32_t blockAlign = s_numChannels * s_bitsPerSample / 8;
+    uint32_t dataSize = static_cast<uint32_t>(frames.size()) * blockAlign;
+
+    file.write("RIFF", 4);
+    WriteU32(file, 4 + (8 + 16) + (8 + dataSize));
+    file.write("WAVE", 4);
+
+    file.write("fmt ", 4);
+    WriteU32(file, 16);
+    WriteU16(file, s_formatFloat);
+    WriteU16(file, s_numChannels);
+    WriteU32(file, static_cast<uint32_t>(sampleRate));
+    WriteU32(file, static_cast<uint32_t>(sampleRate) * blockAlign);
+    WriteU16(file, static_cast<uint16_t>(blockAlign));
+    WriteU16(file, s_bitsPerSample);
+
+    file.write("data", 4);
+    WriteU32(file, dataSize);
+    for (const AudioFrame& frame : frames) {
+        WriteFloat(file, frame.left);
+        WriteFloat(file, frame.right);
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool WavFile::Read(const std::filesystem::path& path, std::vector<AudioFrame>& frames, int& sampleRate) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    // Walk the chunks, skipping any we don't know
+    bool hasFormat = false;
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+        const unsigned char *chunk = bytes.data() + offset;
+        uint32_t chunkSize = ReadU32(chunk + 4);
+        const unsigned char *body = chunk + 8;
+        if (chunkSize > bytes.size() - offset - 8) {
+            return false;
+        }
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16) {
+            if (ReadU16(body) != s_formatFloat || ReadU16(body + 2) != s_numChannels || ReadU16(body + 14) != s_bitsPerSample) {
+                return false;
+            }
+            sampleRate = static_cast<int>(ReadU32(body + 4));
+            hasFormat = true;
+        }else if (std::memcmp(chunk, "data", 4) == 0 && hasFormat) {
+            size_t numFrames = chunkSize / (s_numChannels * sizeof(float));
+            frames.resize(numFrames);
+            for (size_t i = 0; i < numFrames; i++) {
+                frames[i].left = ReadFloat(body + i * 8);
+                frames[i].right = ReadFloat(body + i * 8 + 4);
+            }
+            return true;
+        }
+
+        // Chunks are padded to an even size
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+    return false;
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include "engine/AudioFrame.hpp"
+
+namespace WavFile {
+
+// Writes stereo 32-bit float samples, so levels above full scale survive for inspection.
+// Returns false if the file couldn't be written.
+bool Write(const std::filesystem::path& path, const std::vector<AudioFrame>& frames, int sampleRate);
+
+// Reads a file in the format Write() produces. Returns false if it can't be read or is in any
+// other format.
+bool Read(const std::filesystem::path& path, std::vector<AudioFrame>& frames, int& sampleRate);
+
+} // namespace WavFile
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "golden/AudioComparer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+
+namespace {
+    // Windows and bands quieter than this in both fingerprints are left out, so noise near the
+    // floor of the analyzer doesn't count as a change in the sound
+    constexpr float s_audibleDb = -80.0f;
+
+    bool IsAudible(float a, float b) {
+        return std::max(a, b) > s_audibleDb;
+    }
+}
+
+AudioComparison AudioComparer::Compare(const AudioFingerprint& render, const AudioFingerprint& reference) {
+    AudioComparison comparison;
+    comparison.lengthMatches = render.numFrames == reference.numFrames;
+    comparison.identical = comparison.lengthMatches && render.checksum == reference.checksum;
+
+    size_t numWindows = std::min(render.levelsDb.size(), reference.levelsDb.size());
+    for (size_t window = 0; window < numWindows; window++) {
+        for (size_t channel = 0; channel < 2; channel++) {
+            float a = render.levelsDb[window][channel];
+            float b = reference.levelsDb[window][channel];
+            if (!std::isfinite(a)) {
+                // A NaN would compare false against any tolerance
+                comparison.levelDifferenceDb = std::numeric_limits<double>::infinity();
+            }else if (IsAudible(a, b)) {
+                comparison.levelDifferenceDb = std::max(comparison.levelDifferenceDb, static_cast<double>(std::abs(a - b)));
+            }
+        }
+    }
+
+    double sum = 0.0;
+    size_t numBands = 0;
+    numWindows = std::min(render.spectraDb.size(), reference.spectraDb.size());
+    for (size_t window = 0; window < numWindows; window++) {
+        const std::vector<float>& a = render.spectraDb[window];
+        const std::vector<float>& b = reference.spectraDb[window];
+        for (size_t band = 0; band < std::min(a.size(), b.size()); band++) {
+            if (!std::isfinite(a[band])) {
+                sum = std::numeric_limits<double>::infinity();
+            }else if (IsAudible(a[band], b[band])) {
+                sum += std::abs(a[band] - b[band]);
+                numBands++;
+            }
+        }
+    }
+    comparison.spectralDifferenceDb = numBands > 0 ? sum / numBands : sum;
+
+    comparison.loudnessDifference = render.loudnessLufs - reference.loudnessLufs;
+    comparison.peakDifferenceDb = render.peakDb - reference.peakDb;
+    return comparison;
+}
+
+std::vector<std::string> AudioComparer::FindViolations(const AudioComparison& comparison, const ComparisonTolerances& tolerances) {
+    std::vector<std::string> violations;
+    if (comparison.identical) {
+        return violations;
+    }
+    if (!comparison.lengthMatches) {
+        violations.push_back("length differs");
+    }
+    if (!(comparison.levelDifferenceDb <= tolerances.maxLevelDifferenceDb)) {
+        violations.push_back(std::format("level difference {:.2f} dB > {:.2f} dB", comparison.levelDifferenceDb, tolerances.maxLevelDifferenceDb));
+    }
+    if (!(comparison.spectralDifferenceDb <= tolerances.maxSpectralDifferenceDb)) {
+        violations.push_back(std::format("spectral difference {:.2f} dB > {:.2f} dB", comparison.spectralDifferenceDb, tolerances.maxSpectralDifferenceDb));
+    }
+    if (!(std::abs(comparison.loudnessDifference) <= tolerances.maxLoudnessDifference)) {
+        violations.push_back(std::format("loudness difference {:+.2f} LU > {:.2f} LU", comparison.loudnessDifference, tolerances.maxLoudnessDifference));
+    }
+    return violations;
+}
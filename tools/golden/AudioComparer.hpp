@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "golden/AudioFingerprint.hpp"
+
+// How far a render is from its reference, measured four ways: by checksum (any change at all),
+// by level over time (when it got louder or quieter), by spectrum (what changed in the sound)
+// and by loudness (how much louder overall)
+struct AudioComparison {
+    bool lengthMatches = true;
+    bool identical = false;             // Same checksum, so sample for sample the same render
+    double levelDifferenceDb = 0.0;     // Largest difference of any channel in any audible window
+    double spectralDifferenceDb = 0.0;  // Mean difference of the band spectra, over audible bands
+    double loudnessDifference = 0.0;    // LU, render minus reference
+    double peakDifferenceDb = 0.0;      // Render minus reference
+};
+
+// A render that isn't identical to its reference passes if it's within all of these. The
+// fingerprints keep no phase, so a change that only shifts it (an LFO starting elsewhere in its
+// cycle, say) passes as long as the levels and spectra hold; the report still marks the render
+// as not identical.
+struct ComparisonTolerances {
+    double maxLevelDifferenceDb = 0.05;
+    double maxSpectralDifferenceDb = 0.05;
+    double maxLoudnessDifference = 0.1;
+};
+
+namespace AudioComparer {
+
+AudioComparison Compare(const AudioFingerprint& render, const AudioFingerprint& reference);
+
+// A line for each tolerance the comparison exceeds, empty if it passes
+std::vector<std::string> FindViolations(const AudioComparison& comparison, const ComparisonTolerances& tolerances);
+
+} // namespace AudioComparer
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#include "golden/AudioFingerprint.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <ostream>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "common/AudioAnalysis.hpp"
+#include "fft/FFTAnalyzer.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+    // Third-octave bands centered on 1 kHz * 2^(k/3), from 25 Hz to 20 kHz
+    constexpr int s_lowestBand = -16;
+    constexpr int s_highestBand = 13;
+
+    float Round(double db) {
+        return static_cast<float>(std::round(std::max(db, static_cast<double>(MIN_DB)) * 100.0) / 100.0);
+    }
+
+    void Hash(uint64_t& hash, float sample) {
+        uint32_t bits = std::bit_cast<uint32_t>(sample);
+        for (int i = 0; i < 4; i++) {
+            hash ^= (bits >> (8 * i)) & 0xff;
+            hash *= 0x100000001b3;
+        }
+    }
+
+    // The range of bins each band averages. A band too narrow to hold a bin takes the one
+    // nearest its center.
+    std::vector<std::pair<size_t, size_t>> GetBandBins(int sampleRate, size_t numBins) {
+        double binWidth = static_cast<double>(sampleRate) / Fingerprinting::WINDOW_SIZE;
+        std::vector<std::pair<size_t, size_t>> bands;
+        for (int k = s_lowestBand; k <= s_highestBand; k++) {
+            double center = 1000.0 * std::exp2(k / 3.0);
+            if (center * std::exp2(1.0 / 6.0) > sampleRate / 2.0) {
+                break;
+            }
+            size_t first = static_cast<size_t>(std::ceil(center * std::exp2(-1.0 / 6.0) / binWidth));
+            size_t end = static_cast<size_t>(std::ceil(center * std::exp2(1.0 / 6.0) / binWidth));
+            if (first >= end) {
+                first = std::min(static_cast<size_t>(std::round(center / binWidth)), numBins - 1);
+                end = first + 1;
+            }
+            bands.emplace_back(first, std::min(end, numBins));
+        }
+        return bands;
+    }
+}
+
+AudioFingerprint Fingerprinting::Compute(const std::vector<AudioFrame>& frames, int sampleRate) {
+    AudioFingerprint fingerprint;
+    fingerprint.sampleRate = sampleRate;
+    fingerprint.numFrames = frames.size();
+
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const AudioFrame& frame : frames) {
+        Hash(hash, frame.left);
+        Hash(hash, frame.right);
+    }
+    fingerprint.checksum = std::format("{:016x}", hash);
+
+    LevelAnalysis levels = AudioAnalysis::Analyze(frames, sampleRate);
+    fingerprint.loudnessLufs = levels.loudnessLufs;
+    fingerprint.peakDb = levels.peakDb;
+
+    FFTAnalyzer analyzer(WINDOW_SIZE);
+    std::vector<float> mid(WINDOW_SIZE);
+    std::vector<float> magnitudes(analyzer.GetNumBins());
+    std::vector<std::pair<size_t, size_t>> bands = GetBandBins(sampleRate, magnitudes.size());
+
+    for (size_t start = 0; start + WINDOW_SIZE <= frames.size(); start += WINDOW_SIZE) {
+        double energy[2] = { 0.0, 0.0 };
+        for (size_t i = 0; i < WINDOW_SIZE; i++) {
+            const AudioFrame& frame = frames[start + i];
+            energy[0] += static_cast<double>(frame.left) * frame.left;
+            energy[1] += static_cast<double>(frame.right) * frame.right;
+            mid[i] = 0.5f * (frame.left + frame.right);
+        }
+        fingerprint.levelsDb.push_back({
+            Round(10.0 * std::log10(energy[0] / WINDOW_SIZE)),
+            Round(10.0 * std::log10(energy[1] / WINDOW_SIZE))
+        });
+
+        // The analyzer normalizes its dB range to [0, 1]
+        analyzer.ComputeMagnitudes(mid.data(), magnitudes.data());
+        std::vector<float>& spectrum = fingerprint.spectraDb.emplace_back();
+        for (auto [first, end] : bands) {
+            double sum = 0.0;
+            for (size_t bin = first; bin < end; bin++) {
+                sum += magnitudes[bin];
+            }
+            spectrum.push_back(Round(MIN_DB + sum / (end - first) * (MAX_DB - MIN_DB)));
+        }
+    }
+    return fingerprint;
+}
+
+bool Fingerprinting::Write(const std::filesystem::path& path, const AudioFingerprint& fingerprint) {
+    // A window per line keeps diffs of the references readable. The values go through double,
+    // rounded again, so they're written as their two decimals rather than the float's expansion.
+    auto writeWindows = [](std::ostream& out, const auto& windows) {
+        out << "[\n";
+        for (size_t i = 0; i < windows.size(); i++) {
+            json window = json::array();
+            for (float db : windows[i]) {
+                window.push_back(std::round(db * 100.0) / 100.0);
+            }
+            out << "        " << window.dump() << (i + 1 < windows.size() ? ",\n" : "\n");
+        }
+        out << "    ]";
+    };
+
+    std::ofstream file(path);
+    file << "{\n"
+         << "    \"sampleRate\": " << fingerprint.sampleRate << ",\n"
+         << "    \"numFrames\": " << fingerprint.numFrames << ",\n"
+         << "    \"checksum\": " << json(fingerprint.checksum).dump() << ",\n"
+         << "    \"loudnessLufs\": " << json(fingerprint.loudnessLufs).dump() << ",\n"
+         << "    \"peakDb\": " << json(fingerprint.peakDb).dump() << ",\n"
+         << "    \"windowSize\": " << WINDOW_SIZE << ",\n"
+         << "    \"levelsDb\": ";
+    writeWindows(file, fingerprint.levelsDb);
+    file << ",\n    \"spectraDb\": ";
+    writeWindows(file, fingerprint.spectraDb);
+    file << "\n}\n";
+    return static_cast<bool>(file);
+}
+
+bool Fingerprinting::Read(const std::filesystem::path& path, AudioFingerprint& fingerprint) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    try {
+        json j = json::parse(file);
+        if (j.at("windowSize").get<size_t>() != WINDOW_SIZE) {
+            return false;
+        }
+        fingerprint.sampleRate = j.at("sampleRate").get<int>();
+        fingerprint.numFrames = j.at("numFrames").get<size_t>();
+        fingerprint.checksum = j.at("checksum").get<std::string>();
+        fingerprint.loudnessLufs = j.at("loudnessLufs").get<double>();
+        fingerprint.peakDb = j.at("peakDb").get<double>();
+        fingerprint.levelsDb = j.at("levelsDb").get<std::vector<std::array<float, 2>>>();
+        fingerprint.spectraDb = j.at("spectraDb").get<std::vector<std::vector<float>>>();
+    }catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
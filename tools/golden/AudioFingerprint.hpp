@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "engine/AudioFrame.hpp"
+
+// What a golden reference keeps of a render: a checksum of its exact samples, and enough of how
+// it sounds to judge a render that isn't bit-identical. A few kilobytes per preset, so the
+// references can be committed alongside the presets.
+struct AudioFingerprint {
+    int sampleRate = 0;
+    size_t numFrames = 0;
+    std::string checksum;                       // FNV-1a over the bits of every sample, in hex
+    double loudnessLufs = 0.0;                  // Integrated loudness (ITU-R BS.1770), gated
+    double peakDb = 0.0;                        // dBFS
+    std::vector<std::array<float, 2>> levelsDb; // RMS of the left and right channels, per window
+    std::vector<std::vector<float>> spectraDb;  // Third-octave bands of the mid channel, per window
+};
+
+namespace Fingerprinting {
+
+// Frames per window of levelsDb and spectraDb. Frames after the last whole window only count
+// towards the checksum, loudness and peak.
+inline constexpr size_t WINDOW_SIZE = 4096;
+
+// Levels and bands are in dB, floored at MIN_DB and rounded to 0.01 dB
+AudioFingerprint Compute(const std::vector<AudioFrame>& frames, int sampleRate);
+
+// Returns false if the file couldn't be written
+bool Write(const std::filesystem::path& path, const AudioFingerprint& fingerprint);
+
+// Returns false if the file can't be read or isn't a fingerprint
+bool Read(const std::filesystem::path& path, AudioFingerprint& fingerprint);
+
+} // namespace Fingerprinting
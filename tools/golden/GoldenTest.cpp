@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Ludvig Sandh
+
+// Golden-audio regression test. Renders every preset against the standard note script and
+// compares it with the fingerprint of a reference render, so changes meant to be inaudible
+// (optimizations, refactors) can be shown to be. A render with the reference's checksum passes
+// outright, any other has to be within the tolerances.
+//
+// Usage: chirp-golden-test [--update] [--presets DIR] [--references DIR] [--output DIR] [--jobs N]
+//                          [--max-level-db X] [--max-spectral-db X] [--max-loudness-lu X]
+//
+// --update writes the fingerprints of the renders as the references instead of checking against
+// them. Otherwise the diff report goes to the output folder, along with the render of every
+// preset that failed. Exits with 1 if any preset failed, and with 2 if any reference is missing.
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "common/OfflineRenderer.hpp"
+#include "common/ParallelFor.hpp"
+#include "common/PresetFiles.hpp"
+#include "common/WavFile.hpp"
+#include "golden/AudioComparer.hpp"
+#include "golden/AudioFingerprint.hpp"
+#include "engine/ProcessSpec.hpp"
+#include "preset/AudioPresetSerialization.hpp"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+    // The references were rendered in blocks of this size. Parameters glide per block segment,
+    // so other sizes sound the same but don't match the checksums.
+    constexpr size_t s_blockSize = 256;
+    // At other rates the references would no longer line up
+    constexpr int s_sampleRate = static_cast<int>(ProcessSpec::DEFAULT_SAMPLE_RATE);
+
+    struct Options {
+        bool update = false;
+        fs::path presetsFolder = "presets";
+        fs::path referencesFolder = "tests/golden";
+        fs::path outputFolder = "golden_diff";
+        size_t numJobs = GetDefaultNumJobs();
+        ComparisonTolerances tolerances;
+    };
+
+    struct PresetResult {
+        fs::path file;
+        bool missingReference = false;
+        bool hasComparison = false;
+        AudioComparison comparison;
+        std::vector<std::string> failures;
+    };
+
+    template <typename T>
+    bool ParseNumber(std::string_view text, T& value) {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size() && value > 0;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string_view arg = argv[i];
+            if (arg == "--update") {
+                options.update = true;
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string_view value = argv[++i];
+
+            bool valid = true;
+            if (arg == "--presets") {
+                options.presetsFolder = value;
+            }else if (arg == "--references") {
+                options.referencesFolder = value;
+            }else if (arg == "--output") {
+                options.outputFolder = value;
+            }else if (arg == "--jobs") {
+                valid = ParseNumber(value, options.numJobs);
+            }else if (arg == "--max-level-db") {
+                valid = ParseNumber(value, options.tolerances.maxLevelDifferenceDb);
+            }else if (arg == "--max-spectral-db") {
+                valid = ParseNumber(value, options.tolerances.maxSpectralDifferenceDb);
+            }else if (arg == "--max-loudness-lu") {
+                valid = ParseNumber(value, options.tolerances.maxLoudnessDifference);
+            }else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+
+            if (!valid) {
+                std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    fs::path GetPath(const fs::path& folder, const fs::path& presetFile, std::string_view extension) {
+        fs::path path = folder / presetFile.stem();
+        path += extension;
+        return path;
+    }
+
+    void CheckPreset(PresetResult& result, const NoteScript& script, const Options& options) {
+        AudioPreset preset;
+        if (!AudioPresetIO::LoadFromFile(preset, result.file.string())) {
+            result.failures.push_back("failed to load preset");
+            return;
+        }
+
+        RenderResult render = OfflineRenderer::Render(preset, script, s_blockSize, s_sampleRate);
+
+        AudioFingerprint fingerprint = Fingerprinting::Compute(render.frames, s_sampleRate);
+
+        fs::path referencePath = GetPath(options.referencesFolder, result.file, ".json");
+        if (options.update) {
+            if (!Fingerprinting::Write(referencePath, fingerprint)) {
+                result.failures.push_back("failed to write reference");
+            }
+            return;
+        }
+
+        AudioFingerprint reference;
+        if (!Fingerprinting::Read(referencePath, reference)) {
+            result.missingReference = true;
+            result.failures.push_back("no readable reference at " + referencePath.string());
+            return;
+        }
+        if (reference.sampleRate != s_sampleRate) {
+            result.failures.push_back("reference has a different sample rate");
+            return;
+        }
+
+        result.comparison = AudioComparer::Compare(fingerprint, reference);
+        result.hasComparison = true;
+        result.failures = AudioComparer::FindViolations(result.comparison, options.tolerances);
+        if (!result.failures.empty()) {
+            // Keep what's needed to listen to the change
+            WavFile::Write(GetPath(options.outputFolder, result.file, ".wav"), render.frames, s_sampleRate);
+        }
+    }
+
+    json ToJson(const PresetResult& result) {
+        json j;
+        j["name"] = result.file.stem().string();
+        j["passed"] = result.failures.empty();
+        j["failures"] = result.failures;
+        if (result.hasComparison) {
+            const AudioComparison& c = result.comparison;
+            j["lengthMatches"] = c.lengthMatches;
+            j["identical"] = c.identical;
+            j["levelDifferenceDb"] = c.levelDifferenceDb;
+            j["spectralDifferenceDb"] = c.spectralDifferenceDb;
+            j["loudnessDifference"] = c.loudnessDifference;
+            j["peakDifferenceDb"] = c.peakDifferenceDb;
+        }
+        return j;
+    }
+
+    json ToJson(const ComparisonTolerances& tolerances) {
+        json j;
+        j["maxLevelDifferenceDb"] = tolerances.maxLevelDifferenceDb;
+        j["maxSpectralDifferenceDb"] = tolerances.maxSpectralDifferenceDb;
+        j["maxLoudnessDifference"] = tolerances.maxLoudnessDifference;
+        return j;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--update] [--presets DIR] [--references DIR] [--output DIR] [--jobs N]\n"
+                  << "       [--max-level-db X] [--max-spectral-db X] [--max-loudness-lu X]" << std::endl;
+        return 2;
+    }
+
+    std::vector<PresetResult> results;
+    try {
+        for (const fs::path& file : FindPresetFiles(options.presetsFolder)) {
+            PresetResult result;
+            result.file = file;
+            results.push_back(result);
+        }
+        fs::create_directories(options.update ? options.referencesFolder : options.outputFolder);
+    }catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    if (results.empty()) {
+        std::cerr << "No presets found in " << options.presetsFolder << std::endl;
+        return 2;
+    }
+    if (!options.update && !fs::is_directory(options.referencesFolder)) {
+        std::cerr << "No references in " << options.referencesFolder << ", write them with --update on a known good build" << std::endl;
+        return 2;
+    }
+
+    NoteScript script = OfflineRenderer::GetStandardNoteScript();
+    std::mutex outputMutex;
+
+    ParallelFor(results.size(), options.numJobs, [&](size_t i) {
+        PresetResult& result = results[i];
+        try {
+            CheckPreset(result, script, options);
+        }catch (const std::exception& e) {
+            result.failures.push_back(std::string("error: ") + e.what());
+        }
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << (result.failures.empty() ? "  pass " : "  FAIL ") << result.file.stem().string();
+        if (result.failures.empty() && result.hasComparison && !result.comparison.identical) {
+            std::cout << " (within tolerances, not identical)";
+        }
+        for (const std::string& failure : result.failures) {
+            std::cout << "\n         " << failure;
+        }
+        std::cout << std::endl;
+    });
+
+    size_t numFailed = 0;
+    size_t numMissing = 0;
+    for (const PresetResult& result : results) {
+        numFailed += !result.failures.empty();
+        numMissing += result.missingReference;
+    }
+
+    if (options.update) {
+        std::cout << "Wrote " << results.size() - numFailed << " references to " << options.referencesFolder.string() << std::endl;
+        return numFailed > 0 ? 1 : 0;
+    }
+
+    json report;
+    report["tolerances"] = ToJson(options.tolerances);
+    report["failed"] = numFailed;
+    report["presets"] = json::array();
+    for (const PresetResult& result : results) {
+        report["presets"].push_back(ToJson(result));
+    }
+
+    fs::path reportPath = options.outputFolder / "report.json";
+    std::ofstream reportFile(reportPath);
+    reportFile << report.dump(4);
+    if (!reportFile) {
+        std::cerr << "Couldn't write " << reportPath << std::endl;
+        return 2;
+    }
+
+    std::cout << results.size() - numFailed << " of " << results.size() << " presets match their references. "
+              << "Report: " << reportPath.string() << std::endl;
+    if (numMissing > 0) {
+        std::cerr << "Missing " << numMissing << " of " << results.size() << " references, write them with --update on a known good build" << std::endl;
+        return 2;
+    }
+    return numFailed > 0 ? 1 : 0;
+}